@@ -0,0 +1,317 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerAnalysisCache.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+
+namespace ObjRefAnalysisCache
+{
+	/** TSharedPtr 引用计数控制块的估算大小 */
+	const SIZE_T SharedControllerBytes = 2 * sizeof(void*) + 2 * sizeof(int32);
+
+	/** 缓存项在键表中的估算开销（键、值、哈希链与稀疏数组管理） */
+	const SIZE_T KeyEntryBytes = sizeof(FObjectKey) + sizeof(int32) + 4 * sizeof(int32);
+}
+
+FObjRefAnalysisStamp FObjRefAnalysisStamp::FromGraph(const FObjRefReferenceGraph& Graph)
+{
+	FObjRefAnalysisStamp Stamp;
+	Stamp.GCEpoch = Graph.GetGCEpoch();
+	Stamp.GraphVersion = Graph.GetVersion();
+	return Stamp;
+}
+
+bool FObjRefAnalysisStamp::IsNewerThan(const FObjRefAnalysisStamp& Other) const
+{
+	if (GCEpoch != Other.GCEpoch)
+	{
+		return static_cast<int32>(GCEpoch - Other.GCEpoch) > 0;
+	}
+	return static_cast<int32>(GraphVersion - Other.GraphVersion) > 0;
+}
+
+FObjRefAnalysisCache::FObjRefAnalysisCache(SIZE_T InBudgetBytes)
+	: Head(INDEX_NONE)
+	, Tail(INDEX_NONE)
+	, BudgetBytes(InBudgetBytes)
+	, UsedBytes(0)
+	, NumHits(0)
+	, NumMisses(0)
+	, NumEvictions(0)
+{
+}
+
+void FObjRefAnalysisCache::SetBudget(SIZE_T InBudgetBytes)
+{
+	BudgetBytes = InBudgetBytes;
+	EvictToBudget(INDEX_NONE);
+}
+
+void FObjRefAnalysisCache::Reset()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	EntryIndexByKey.Empty();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+	UsedBytes = 0;
+}
+
+void FObjRefAnalysisCache::ResetReferenceChains()
+{
+	for (int32 EntryIndex = Head; EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		if (Entry.bHasChains)
+		{
+			Entry.ChainRoots.Empty();
+			Entry.bHasChains = false;
+			UpdateEntryBytes(EntryIndex);
+		}
+	}
+}
+
+const TArray<TSharedPtr<FReferencerInfo>>* FObjRefAnalysisCache::FindReferencers(const UObject* Object, const FObjRefAnalysisStamp& Stamp)
+{
+	const int32 EntryIndex = SyncStamp(Stamp) ? Touch(Object) : INDEX_NONE;
+	if (EntryIndex == INDEX_NONE || !Entries[EntryIndex].bHasReferencers)
+	{
+		++NumMisses;
+		return nullptr;
+	}
+
+	++NumHits;
+	return &Entries[EntryIndex].Referencers;
+}
+
+const TArray<TSharedPtr<FReferenceChainNode>>* FObjRefAnalysisCache::FindReferenceChains(const UObject* Object, const FObjRefAnalysisStamp& Stamp)
+{
+	const int32 EntryIndex = SyncStamp(Stamp) ? Touch(Object) : INDEX_NONE;
+	if (EntryIndex == INDEX_NONE || !Entries[EntryIndex].bHasChains)
+	{
+		++NumMisses;
+		return nullptr;
+	}
+
+	// 穷举模式的链节点在展开时按需生成，命中时重新估算大小，展开得越多占用的预算越多
+	UpdateEntryBytes(EntryIndex);
+	EvictToBudget(EntryIndex);
+
+	++NumHits;
+	return &Entries[EntryIndex].ChainRoots;
+}
+
+void FObjRefAnalysisCache::AddReferencers(const UObject* Object, const FObjRefAnalysisStamp& Stamp, const TArray<TSharedPtr<FReferencerInfo>>& Referencers)
+{
+	if (!SyncStamp(Stamp) || !IsValid(Object))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = FindOrAddEntry(Object);
+	Entries[EntryIndex].Referencers = Referencers;
+	Entries[EntryIndex].bHasReferencers = true;
+	UpdateEntryBytes(EntryIndex);
+	EvictToBudget(EntryIndex);
+}
+
+void FObjRefAnalysisCache::AddReferenceChains(const UObject* Object, const FObjRefAnalysisStamp& Stamp, const TArray<TSharedPtr<FReferenceChainNode>>& ChainRoots)
+{
+	if (!SyncStamp(Stamp) || !IsValid(Object))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = FindOrAddEntry(Object);
+	Entries[EntryIndex].ChainRoots = ChainRoots;
+	Entries[EntryIndex].bHasChains = true;
+	UpdateEntryBytes(EntryIndex);
+	EvictToBudget(EntryIndex);
+}
+
+SIZE_T FObjRefAnalysisCache::MeasureReferencers(const TArray<TSharedPtr<FReferencerInfo>>& Referencers)
+{
+	using namespace ObjRefAnalysisCache;
+
+	SIZE_T Bytes = Referencers.GetAllocatedSize();
+	for (const TSharedPtr<FReferencerInfo>& Info : Referencers)
+	{
+		if (Info.IsValid())
+		{
+			Bytes += sizeof(FReferencerInfo) + SharedControllerBytes
+				+ Info->ReferencerName.GetAllocatedSize()
+				+ Info->ReferencerClass.GetAllocatedSize()
+				+ Info->PropertyName.GetAllocatedSize();
+		}
+	}
+	return Bytes;
+}
+
+SIZE_T FObjRefAnalysisCache::MeasureReferenceChains(const TArray<TSharedPtr<FReferenceChainNode>>& ChainRoots)
+{
+	using namespace ObjRefAnalysisCache;
+
+	SIZE_T Bytes = ChainRoots.GetAllocatedSize();
+
+	// 链节点之间只有 Children 是强引用，构成一棵树，用显式栈遍历避免深链递归
+	TArray<const FReferenceChainNode*> Stack;
+	for (const TSharedPtr<FReferenceChainNode>& Root : ChainRoots)
+	{
+		if (Root.IsValid())
+		{
+			Stack.Add(Root.Get());
+		}
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const FReferenceChainNode* Node = Stack.Pop(false);
+		Bytes += sizeof(FReferenceChainNode) + SharedControllerBytes
+			+ Node->ObjectName.GetAllocatedSize()
+			+ Node->ClassName.GetAllocatedSize()
+			+ Node->PropertyName.GetAllocatedSize()
+			+ Node->Children.GetAllocatedSize();
+
+		for (const TSharedPtr<FReferenceChainNode>& Child : Node->Children)
+		{
+			if (Child.IsValid())
+			{
+				Stack.Add(Child.Get());
+			}
+		}
+	}
+	return Bytes;
+}
+
+bool FObjRefAnalysisCache::SyncStamp(const FObjRefAnalysisStamp& Stamp)
+{
+	if (Stamp == CachedStamp)
+	{
+		return true;
+	}
+
+	// 较新的引用图状态使全部缓存失效，按较旧状态计算的结果直接丢弃
+	if (Stamp.IsNewerThan(CachedStamp))
+	{
+		Reset();
+		CachedStamp = Stamp;
+		return true;
+	}
+	return false;
+}
+
+int32 FObjRefAnalysisCache::Touch(const UObject* Object)
+{
+	if (!IsValid(Object))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* EntryIndex = EntryIndexByKey.Find(FObjectKey(Object));
+	if (!EntryIndex)
+	{
+		return INDEX_NONE;
+	}
+
+	if (*EntryIndex != Head)
+	{
+		Unlink(*EntryIndex);
+		LinkAtHead(*EntryIndex);
+	}
+	return *EntryIndex;
+}
+
+int32 FObjRefAnalysisCache::FindOrAddEntry(const UObject* Object)
+{
+	const int32 ExistingIndex = Touch(Object);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(false) : Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Key = FObjectKey(Object);
+	Entry.bHasReferencers = false;
+	Entry.bHasChains = false;
+	Entry.Bytes = 0;
+
+	EntryIndexByKey.Add(Entry.Key, EntryIndex);
+	LinkAtHead(EntryIndex);
+	return EntryIndex;
+}
+
+void FObjRefAnalysisCache::UpdateEntryBytes(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	UsedBytes -= Entry.Bytes;
+	Entry.Bytes = sizeof(FEntry) + ObjRefAnalysisCache::KeyEntryBytes
+		+ MeasureReferencers(Entry.Referencers)
+		+ MeasureReferenceChains(Entry.ChainRoots);
+	UsedBytes += Entry.Bytes;
+}
+
+void FObjRefAnalysisCache::EvictToBudget(int32 KeepIndex)
+{
+	// 刚写入的项即使单独超出预算也保留，它就是当前显示的结果
+	while (UsedBytes > BudgetBytes && Tail != INDEX_NONE && Tail != KeepIndex)
+	{
+		RemoveEntry(Tail);
+		++NumEvictions;
+	}
+}
+
+void FObjRefAnalysisCache::RemoveEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Unlink(EntryIndex);
+	EntryIndexByKey.Remove(Entry.Key);
+	UsedBytes -= Entry.Bytes;
+
+	Entry.Referencers.Empty();
+	Entry.ChainRoots.Empty();
+	Entry.bHasReferencers = false;
+	Entry.bHasChains = false;
+	Entry.Bytes = 0;
+	FreeEntries.Add(EntryIndex);
+}
+
+void FObjRefAnalysisCache::LinkAtHead(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = EntryIndex;
+	}
+	Head = EntryIndex;
+	if (Tail == INDEX_NONE)
+	{
+		Tail = EntryIndex;
+	}
+}
+
+void FObjRefAnalysisCache::Unlink(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Head = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else
+	{
+		Tail = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
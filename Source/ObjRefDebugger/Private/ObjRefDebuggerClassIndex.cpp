@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerClassIndex.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/Blueprint.h"
+#include "Editor.h"
+
+FObjRefClassIndex::FObjRefClassIndex()
+	: bIsDirty(true)
+{
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FObjRefClassIndex::OnModulesChanged);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FObjRefClassIndex::OnAssetLoaded);
+
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FObjRefClassIndex::Invalidate);
+		ClassPackageLoadedHandle = GEditor->OnClassPackageLoadedOrUnloaded().AddRaw(this, &FObjRefClassIndex::Invalidate);
+	}
+}
+
+FObjRefClassIndex::~FObjRefClassIndex()
+{
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+		GEditor->OnClassPackageLoadedOrUnloaded().Remove(ClassPackageLoadedHandle);
+	}
+}
+
+void FObjRefClassIndex::Invalidate()
+{
+	bIsDirty = true;
+	MissedNames.Reset();
+}
+
+void FObjRefClassIndex::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	Invalidate();
+}
+
+void FObjRefClassIndex::OnAssetLoaded(UObject* Asset)
+{
+	// 随资源加载的蓝图类不会触发类包通知
+	if (Asset && Asset->IsA<UBlueprint>())
+	{
+		Invalidate();
+	}
+}
+
+bool FObjRefClassIndex::IsIndexableClass(const UClass* Class)
+{
+	if (!IsValid(Class) || Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+	{
+		return false;
+	}
+
+	// 蓝图编译和热重载产生的临时类不参与按名查找
+	const FString ClassName = Class->GetName();
+	return !ClassName.StartsWith(TEXT("SKEL_"))
+		&& !ClassName.StartsWith(TEXT("REINST_"))
+		&& !ClassName.StartsWith(TEXT("TRASHCLASS_"))
+		&& !ClassName.StartsWith(TEXT("HOTRELOADED_"));
+}
+
+void FObjRefClassIndex::Rebuild()
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	ClassesByPath.Reset();
+	ClassesByName.Reset();
+	MissedNames.Reset();
+
+	// 通过类哈希只枚举 UClass 及其派生类型的对象，不遍历整个对象数组
+	ForEachObjectOfClass(UClass::StaticClass(), [this](UObject* Object)
+	{
+		UClass* Class = static_cast<UClass*>(Object);
+		if (!IsIndexableClass(Class))
+		{
+			return;
+		}
+
+		ClassesByPath.Add(FName(*Class->GetPathName()), Class);
+
+		TArray<TWeakObjectPtr<UClass>, TInlineAllocator<1>>& SameNameClasses = ClassesByName.FindOrAdd(Class->GetFName());
+		if (Class->HasAnyClassFlags(CLASS_Native))
+		{
+			SameNameClasses.Insert(Class, 0);
+		}
+		else
+		{
+			SameNameClasses.Add(Class);
+		}
+	}, true, RF_NoFlags, EInternalObjectFlags::PendingKill);
+
+	bIsDirty = false;
+
+	UE_LOG(LogTemp, Log, TEXT("类名索引重建完成: %d 个类, 用时 %.3f 秒"), ClassesByPath.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+UClass* FObjRefClassIndex::FindClassInIndex(const FString& ClassName) const
+{
+	// 带包路径的名字按完整路径查找，其余按短名查找
+	if (ClassName.Contains(TEXT("/")) || ClassName.Contains(TEXT(".")))
+	{
+		const TWeakObjectPtr<UClass>* Found = ClassesByPath.Find(FName(*ClassName, FNAME_Find));
+		UClass* Class = Found ? Found->Get() : nullptr;
+		return IsIndexableClass(Class) ? Class : nullptr;
+	}
+
+	const FName ShortName(*ClassName, FNAME_Find);
+	if (ShortName.IsNone())
+	{
+		return nullptr;
+	}
+
+	if (const TArray<TWeakObjectPtr<UClass>, TInlineAllocator<1>>* SameNameClasses = ClassesByName.Find(ShortName))
+	{
+		for (const TWeakObjectPtr<UClass>& WeakClass : *SameNameClasses)
+		{
+			UClass* Class = WeakClass.Get();
+			if (IsIndexableClass(Class))
+			{
+				return Class;
+			}
+		}
+	}
+	return nullptr;
+}
+
+UClass* FObjRefClassIndex::FindClass(const FString& ClassName)
+{
+	check(IsInGameThread());
+
+	if (ClassName.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	if (bIsDirty)
+	{
+		Rebuild();
+	}
+
+	if (MissedNames.Contains(ClassName))
+	{
+		return nullptr;
+	}
+
+	UClass* Class = FindClassInIndex(ClassName);
+	if (!Class)
+	{
+		MissedNames.Add(ClassName);
+	}
+	return Class;
+}
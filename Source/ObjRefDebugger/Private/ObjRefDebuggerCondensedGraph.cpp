@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerCondensedGraph.h"
+
+FObjRefCondensedGraph::FObjRefCondensedGraph()
+	: ComputedGCEpoch(0)
+	, ComputedGraphVersion(0)
+	, bHasResult(false)
+{
+}
+
+void FObjRefCondensedGraph::Reset()
+{
+	ComponentIds.Empty();
+	MemberOffsets.Empty();
+	Members.Empty();
+	ComponentRootKinds.Empty();
+	InEdgeOffsets.Empty();
+	InEdges.Empty();
+	bHasResult = false;
+}
+
+bool FObjRefCondensedGraph::IsUpToDate(const FObjRefReferenceGraph& Graph) const
+{
+	return bHasResult && ComputedGCEpoch == Graph.GetGCEpoch();
+}
+
+bool FObjRefCondensedGraph::IsLatestVersion(const FObjRefReferenceGraph& Graph) const
+{
+	return bHasResult && ComputedGraphVersion == Graph.GetVersion() && Graph.IsUpToDate();
+}
+
+TArrayView<const int32> FObjRefCondensedGraph::GetMembers(int32 ComponentId) const
+{
+	if (ComponentId < 0 || ComponentId + 1 >= MemberOffsets.Num())
+	{
+		return TArrayView<const int32>();
+	}
+	const int32 Begin = MemberOffsets[ComponentId];
+	return TArrayView<const int32>(Members.GetData() + Begin, MemberOffsets[ComponentId + 1] - Begin);
+}
+
+TArrayView<const FObjRefCondensedEdge> FObjRefCondensedGraph::GetReferencingComponents(int32 ComponentId) const
+{
+	if (ComponentId < 0 || ComponentId + 1 >= InEdgeOffsets.Num())
+	{
+		return TArrayView<const FObjRefCondensedEdge>();
+	}
+	const int32 Begin = InEdgeOffsets[ComponentId];
+	return TArrayView<const FObjRefCondensedEdge>(InEdges.GetData() + Begin, InEdgeOffsets[ComponentId + 1] - Begin);
+}
+
+SIZE_T FObjRefCondensedGraph::GetAllocatedSize() const
+{
+	return ComponentIds.GetAllocatedSize()
+		+ MemberOffsets.GetAllocatedSize()
+		+ Members.GetAllocatedSize()
+		+ ComponentRootKinds.GetAllocatedSize()
+		+ InEdgeOffsets.GetAllocatedSize()
+		+ InEdges.GetAllocatedSize();
+}
+
+void FObjRefCondensedGraph::Compute(const FObjRefReferenceGraph& Graph)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 NumObjects = Graph.GetNumObjects();
+
+	// 1. 存活对象的正向邻接整理成本地 CSR，迭代时需要按游标续扫
+	TBitArray<> Alive(false, NumObjects);
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		if (FObjRefReferenceGraph::GetObjectByIndex(ObjectIndex))
+		{
+			Alive[ObjectIndex] = true;
+		}
+	}
+
+	TArray<int32> SuccOffsets;
+	TArray<int32> SuccTargets;
+	SuccOffsets.SetNumUninitialized(NumObjects + 1);
+	SuccTargets.Reserve(Graph.GetNumEdges());
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		SuccOffsets[ObjectIndex] = SuccTargets.Num();
+		if (Alive[ObjectIndex])
+		{
+			Graph.ForEachReference(ObjectIndex, [&SuccTargets, &Alive](int32 TargetIndex)
+			{
+				if (Alive.IsValidIndex(TargetIndex) && Alive[TargetIndex])
+				{
+					SuccTargets.Add(TargetIndex);
+				}
+			});
+		}
+	}
+	SuccOffsets[NumObjects] = SuccTargets.Num();
+
+	// 2. 迭代式 Tarjan：用显式调用栈和每个节点的边游标代替递归
+	TArray<int32> DiscoveryIndex;
+	TArray<int32> LowLink;
+	TArray<int32> Cursors;
+	DiscoveryIndex.Init(INDEX_NONE, NumObjects);
+	LowLink.SetNumUninitialized(NumObjects);
+	Cursors.SetNumUninitialized(NumObjects);
+	TBitArray<> OnStack(false, NumObjects);
+
+	ComponentIds.Reset();
+	ComponentIds.Init(INDEX_NONE, NumObjects);
+
+	TArray<int32> ComponentStack;
+	TArray<int32> CallStack;
+	int32 NextDiscoveryIndex = 0;
+	int32 NumComponents = 0;
+
+	auto Discover = [&](int32 Node)
+	{
+		DiscoveryIndex[Node] = NextDiscoveryIndex;
+		LowLink[Node] = NextDiscoveryIndex;
+		++NextDiscoveryIndex;
+		Cursors[Node] = SuccOffsets[Node];
+		ComponentStack.Add(Node);
+		OnStack[Node] = true;
+		CallStack.Add(Node);
+	};
+
+	for (int32 StartIndex = 0; StartIndex < NumObjects; ++StartIndex)
+	{
+		if (!Alive[StartIndex] || DiscoveryIndex[StartIndex] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Discover(StartIndex);
+		while (CallStack.Num() > 0)
+		{
+			const int32 Node = CallStack.Last();
+			if (Cursors[Node] < SuccOffsets[Node + 1])
+			{
+				const int32 Next = SuccTargets[Cursors[Node]++];
+				if (DiscoveryIndex[Next] == INDEX_NONE)
+				{
+					Discover(Next);
+				}
+				else if (OnStack[Next])
+				{
+					LowLink[Node] = FMath::Min(LowLink[Node], DiscoveryIndex[Next]);
+				}
+				continue;
+			}
+
+			CallStack.Pop(false);
+			if (LowLink[Node] == DiscoveryIndex[Node])
+			{
+				int32 Member;
+				do
+				{
+					Member = ComponentStack.Pop(false);
+					OnStack[Member] = false;
+					ComponentIds[Member] = NumComponents;
+				}
+				while (Member != Node);
+				++NumComponents;
+			}
+			if (CallStack.Num() > 0)
+			{
+				const int32 Caller = CallStack.Last();
+				LowLink[Caller] = FMath::Min(LowLink[Caller], LowLink[Node]);
+			}
+		}
+	}
+	DiscoveryIndex.Empty();
+	LowLink.Empty();
+	Cursors.Empty();
+	SuccOffsets.Empty();
+	SuccTargets.Empty();
+
+	// 3. 按分量分桶成员，并记录分量是否含GC根
+	MemberOffsets.Reset();
+	MemberOffsets.SetNumZeroed(NumComponents + 1);
+	ComponentRootKinds.Reset();
+	ComponentRootKinds.SetNumZeroed(NumComponents);
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		const int32 ComponentId = ComponentIds[ObjectIndex];
+		if (ComponentId == INDEX_NONE)
+		{
+			continue;
+		}
+		++MemberOffsets[ComponentId + 1];
+
+		const EObjRefRootKind RootKind = Graph.GetRootKind(ObjectIndex);
+		if (RootKind != EObjRefRootKind::None && ComponentRootKinds[ComponentId] == static_cast<uint8>(EObjRefRootKind::None))
+		{
+			ComponentRootKinds[ComponentId] = static_cast<uint8>(RootKind);
+		}
+	}
+	for (int32 ComponentId = 0; ComponentId < NumComponents; ++ComponentId)
+	{
+		MemberOffsets[ComponentId + 1] += MemberOffsets[ComponentId];
+	}
+	Members.Reset();
+	Members.SetNumUninitialized(MemberOffsets[NumComponents]);
+	{
+		TArray<int32> MemberCursors(MemberOffsets.GetData(), NumComponents);
+		for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+		{
+			const int32 ComponentId = ComponentIds[ObjectIndex];
+			if (ComponentId != INDEX_NONE)
+			{
+				Members[MemberCursors[ComponentId]++] = ObjectIndex;
+			}
+		}
+	}
+
+	// 4. 缩合反向边：跨分量的引用按引用分量去重，保留第一条作为代表边
+	TArray<int32> LastSeenBy;
+	LastSeenBy.Init(INDEX_NONE, NumComponents);
+	InEdgeOffsets.Reset();
+	InEdgeOffsets.SetNumUninitialized(NumComponents + 1);
+	InEdges.Reset();
+	for (int32 ComponentId = 0; ComponentId < NumComponents; ++ComponentId)
+	{
+		InEdgeOffsets[ComponentId] = InEdges.Num();
+		for (int32 TargetIndex : GetMembers(ComponentId))
+		{
+			Graph.ForEachReferencer(TargetIndex, [this, &LastSeenBy, ComponentId, TargetIndex](int32 SourceIndex, int32 PropertyId)
+			{
+				const int32 SourceComponent = GetComponent(SourceIndex);
+				if (SourceComponent == INDEX_NONE || SourceComponent == ComponentId || LastSeenBy[SourceComponent] == ComponentId)
+				{
+					return;
+				}
+				LastSeenBy[SourceComponent] = ComponentId;
+				InEdges.Emplace(SourceComponent, SourceIndex, TargetIndex, PropertyId);
+			});
+		}
+	}
+	InEdgeOffsets[NumComponents] = InEdges.Num();
+
+	ComputedGCEpoch = Graph.GetGCEpoch();
+	ComputedGraphVersion = Graph.GetVersion();
+	bHasResult = true;
+
+	UE_LOG(LogTemp, Log, TEXT("强连通分量计算完成: %d 个对象缩合为 %d 个分量, %d 条缩合边, 用时 %.3f 秒"),
+		Members.Num(), NumComponents, InEdges.Num(), FPlatformTime::Seconds() - StartTime);
+}
@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerDominatorTree.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+
+FObjRefDominatorTree::FObjRefDominatorTree()
+	: ComputedGCEpoch(0)
+	, bHasResult(false)
+{
+}
+
+void FObjRefDominatorTree::Reset()
+{
+	RetainedSizes.Empty();
+	ImmediateDominators.Empty();
+	bHasResult = false;
+}
+
+bool FObjRefDominatorTree::IsUpToDate(const FObjRefReferenceGraph& Graph) const
+{
+	return bHasResult && ComputedGCEpoch == Graph.GetGCEpoch();
+}
+
+void FObjRefDominatorTree::Compute(const FObjRefReferenceGraph& Graph, TFunctionRef<int64(UObject* Object)> GetSelfSize)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 NumObjects = Graph.GetNumObjects();
+	const int32 VirtualRoot = NumObjects;
+
+	// 1. 把正向邻接整理成本地 CSR，虚拟根的后继是所有GC根
+	TArray<int32> SuccOffsets;
+	TArray<int32> SuccTargets;
+	SuccOffsets.SetNumUninitialized(NumObjects + 2);
+	SuccTargets.Reserve(Graph.GetNumEdges() + NumObjects);
+
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		SuccOffsets[ObjectIndex] = SuccTargets.Num();
+		if (FObjRefReferenceGraph::GetObjectByIndex(ObjectIndex))
+		{
+			Graph.ForEachReference(ObjectIndex, [&SuccTargets](int32 TargetIndex)
+			{
+				SuccTargets.Add(TargetIndex);
+			});
+		}
+	}
+	SuccOffsets[VirtualRoot] = SuccTargets.Num();
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		if (Graph.GetRootKind(ObjectIndex) != EObjRefRootKind::None && FObjRefReferenceGraph::GetObjectByIndex(ObjectIndex))
+		{
+			SuccTargets.Add(ObjectIndex);
+		}
+	}
+	SuccOffsets[VirtualRoot + 1] = SuccTargets.Num();
+
+	// 2. 从虚拟根做迭代DFS，按先序编号（从1开始，0表示未访问）
+	TArray<int32> PreOrder;        // 对象索引 -> DFS编号
+	TArray<int32> Vertex;          // DFS编号 -> 对象索引
+	TArray<int32> Parent;          // DFS编号 -> DFS树父节点编号
+	PreOrder.SetNumZeroed(NumObjects + 1);
+	Vertex.Reserve(NumObjects + 2);
+	Parent.Reserve(NumObjects + 2);
+	Vertex.Add(INDEX_NONE);
+	Parent.Add(0);
+
+	TArray<int32> Cursors;
+	Cursors.SetNumUninitialized(NumObjects + 1);
+	TArray<int32> Stack;
+
+	PreOrder[VirtualRoot] = 1;
+	Vertex.Add(VirtualRoot);
+	Parent.Add(0);
+	Cursors[VirtualRoot] = SuccOffsets[VirtualRoot];
+	Stack.Add(VirtualRoot);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Node = Stack.Last();
+		if (Cursors[Node] == SuccOffsets[Node + 1])
+		{
+			Stack.Pop(false);
+			continue;
+		}
+
+		const int32 Next = SuccTargets[Cursors[Node]++];
+		if (PreOrder[Next] == 0 && FObjRefReferenceGraph::GetObjectByIndex(Next))
+		{
+			PreOrder[Next] = Vertex.Num();
+			Vertex.Add(Next);
+			Parent.Add(PreOrder[Node]);
+			Cursors[Next] = SuccOffsets[Next];
+			Stack.Add(Next);
+		}
+	}
+	Cursors.Empty();
+
+	const int32 NumReached = Vertex.Num() - 1;
+
+	// 3. 在DFS编号空间内建立前驱 CSR
+	TArray<int32> PredOffsets;
+	TArray<int32> PredSources;
+	PredOffsets.SetNumZeroed(NumReached + 2);
+	for (int32 V = 1; V <= NumReached; ++V)
+	{
+		const int32 Node = Vertex[V];
+		for (int32 EdgeIndex = SuccOffsets[Node]; EdgeIndex < SuccOffsets[Node + 1]; ++EdgeIndex)
+		{
+			if (const int32 W = PreOrder[SuccTargets[EdgeIndex]])
+			{
+				++PredOffsets[W + 1];
+			}
+		}
+	}
+	for (int32 V = 1; V <= NumReached; ++V)
+	{
+		PredOffsets[V + 1] += PredOffsets[V];
+	}
+	PredSources.SetNumUninitialized(PredOffsets[NumReached + 1]);
+	{
+		TArray<int32> PredCursors(PredOffsets.GetData(), NumReached + 1);
+		for (int32 V = 1; V <= NumReached; ++V)
+		{
+			const int32 Node = Vertex[V];
+			for (int32 EdgeIndex = SuccOffsets[Node]; EdgeIndex < SuccOffsets[Node + 1]; ++EdgeIndex)
+			{
+				if (const int32 W = PreOrder[SuccTargets[EdgeIndex]])
+				{
+					PredSources[PredCursors[W]++] = V;
+				}
+			}
+		}
+	}
+	SuccOffsets.Empty();
+	SuccTargets.Empty();
+
+	// 4. Lengauer-Tarjan（路径压缩版本），所有数组都以DFS编号为下标
+	TArray<int32> Semi;
+	TArray<int32> Idom;
+	TArray<int32> Ancestor;
+	TArray<int32> Label;
+	TArray<int32> BucketHead;
+	TArray<int32> BucketNext;
+	Semi.SetNumUninitialized(NumReached + 1);
+	Label.SetNumUninitialized(NumReached + 1);
+	Idom.SetNumZeroed(NumReached + 1);
+	Ancestor.SetNumZeroed(NumReached + 1);
+	BucketHead.SetNumZeroed(NumReached + 1);
+	BucketNext.SetNumZeroed(NumReached + 1);
+	for (int32 V = 0; V <= NumReached; ++V)
+	{
+		Semi[V] = V;
+		Label[V] = V;
+	}
+
+	TArray<int32> CompressStack;
+	auto Eval = [&Semi, &Ancestor, &Label, &CompressStack](int32 V) -> int32
+	{
+		if (Ancestor[V] == 0)
+		{
+			return V;
+		}
+
+		// 迭代式路径压缩，避免在百万级深度的链上递归
+		CompressStack.Reset();
+		int32 X = V;
+		while (Ancestor[Ancestor[X]] != 0)
+		{
+			CompressStack.Add(X);
+			X = Ancestor[X];
+		}
+		while (CompressStack.Num() > 0)
+		{
+			X = CompressStack.Pop(false);
+			const int32 A = Ancestor[X];
+			if (Semi[Label[A]] < Semi[Label[X]])
+			{
+				Label[X] = Label[A];
+			}
+			Ancestor[X] = Ancestor[A];
+		}
+		return Label[V];
+	};
+
+	for (int32 W = NumReached; W >= 2; --W)
+	{
+		for (int32 EdgeIndex = PredOffsets[W]; EdgeIndex < PredOffsets[W + 1]; ++EdgeIndex)
+		{
+			const int32 U = Eval(PredSources[EdgeIndex]);
+			if (Semi[U] < Semi[W])
+			{
+				Semi[W] = Semi[U];
+			}
+		}
+
+		BucketNext[W] = BucketHead[Semi[W]];
+		BucketHead[Semi[W]] = W;
+
+		const int32 P = Parent[W];
+		Ancestor[W] = P;
+
+		for (int32 V = BucketHead[P]; V != 0; V = BucketNext[V])
+		{
+			const int32 U = Eval(V);
+			Idom[V] = Semi[U] < Semi[V] ? U : P;
+		}
+		BucketHead[P] = 0;
+	}
+
+	for (int32 W = 2; W <= NumReached; ++W)
+	{
+		if (Idom[W] != Semi[W])
+		{
+			Idom[W] = Idom[Idom[W]];
+		}
+	}
+	Idom[1] = 0;
+
+	// 5. 支配者的DFS编号总是小于被支配者，逆序累加即可得到子树大小
+	TArray<int64> Retained;
+	Retained.SetNumZeroed(NumReached + 1);
+	for (int32 V = 2; V <= NumReached; ++V)
+	{
+		if (UObject* Object = FObjRefReferenceGraph::GetObjectByIndex(Vertex[V]))
+		{
+			Retained[V] = GetSelfSize(Object);
+		}
+	}
+	for (int32 W = NumReached; W >= 2; --W)
+	{
+		Retained[Idom[W]] += Retained[W];
+	}
+
+	// 6. 转回对象索引空间
+	RetainedSizes.Reset();
+	RetainedSizes.Init(INDEX_NONE, NumObjects);
+	ImmediateDominators.Reset();
+	ImmediateDominators.Init(INDEX_NONE, NumObjects);
+	for (int32 V = 2; V <= NumReached; ++V)
+	{
+		const int32 ObjectIndex = Vertex[V];
+		RetainedSizes[ObjectIndex] = Retained[V];
+		ImmediateDominators[ObjectIndex] = Idom[V] > 1 ? Vertex[Idom[V]] : INDEX_NONE;
+	}
+
+	ComputedGCEpoch = Graph.GetGCEpoch();
+	bHasResult = true;
+
+	UE_LOG(LogTemp, Log, TEXT("支配树计算完成: %d 个可达对象, %d 条边, 用时 %.3f 秒"),
+		NumReached - 1, PredSources.Num(), FPlatformTime::Seconds() - StartTime);
+}
@@ -0,0 +1,492 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerInstanceSearch.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/GarbageCollection.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+
+namespace ObjRefInstanceSearch
+{
+	/** 已在GC锁内解析好的搜索上下文 */
+	struct FContext
+	{
+		TArray<UClass*> Targets;
+		TBitArray<> ActorTargets;
+		TArray<UClass*> ExcludedClasses;
+		TArray<UWorld*> Worlds;
+		const FObjRefQuery* Query;
+		const FObjRefJobToken* CancelToken;
+
+		/** 按 Outer 缓存的世界解析，所有工作线程共用 */
+		FObjRefWorldCache* WorldCache;
+	};
+
+	/** 候选对象：对象索引与按类哈希命中的目标类 */
+	struct FCandidate
+	{
+		int32 ObjectIndex;
+		int32 TargetIndex;
+	};
+
+	/** 过滤候选对象，通过时写入匹配结果 */
+	static bool FilterCandidate(const FContext& Context, UObject* Object, int32 ObjectIndex, TArrayView<const int32> TargetIndices, FObjRefSearchMatch& OutMatch)
+	{
+		if (!Context.Query->MatchesObject(Object, *Context.WorldCache))
+		{
+			return false;
+		}
+
+		// Actor 目标类只匹配所选世界中的 Actor；世界在谓词链里已解析过时这里直接命中缓存
+		bool bWorldChecked = false;
+		bool bInSearchedWorld = false;
+
+		OutMatch.MatchedTargets.Reset();
+		for (int32 TargetIndex : TargetIndices)
+		{
+			if (Context.ActorTargets[TargetIndex])
+			{
+				if (!bWorldChecked)
+				{
+					bInSearchedWorld = Context.Worlds.Contains(Context.WorldCache->GetWorld(Object));
+					bWorldChecked = true;
+				}
+				if (!bInSearchedWorld)
+				{
+					continue;
+				}
+			}
+			OutMatch.MatchedTargets.Add(TargetIndex);
+		}
+
+		if (OutMatch.MatchedTargets.Num() == 0)
+		{
+			return false;
+		}
+
+		OutMatch.Object = Object;
+		OutMatch.ObjectIndex = ObjectIndex;
+		OutMatch.WorldIndex = Context.WorldCache->GetWorldIndex(Object);
+		return true;
+	}
+
+	/** 对象所属类匹配的目标类下标（属于排除类时为空），按类缓存，连续的同类对象直接复用上一次结果 */
+	class FClassMembership
+	{
+	public:
+		explicit FClassMembership(const FContext& InContext)
+			: Context(InContext)
+			, LastClass(nullptr)
+			, LastMembership(nullptr)
+		{
+		}
+
+		TArrayView<const int32> Get(const UClass* ObjectClass)
+		{
+			if (ObjectClass != LastClass)
+			{
+				TArray<int32, TInlineAllocator<2>>* Membership = MembershipByClass.Find(ObjectClass);
+				if (!Membership)
+				{
+					Membership = &MembershipByClass.Add(ObjectClass);
+					const bool bExcluded = Context.ExcludedClasses.ContainsByPredicate([ObjectClass](const UClass* ExcludedClass)
+					{
+						return ObjectClass->IsChildOf(ExcludedClass);
+					});
+					for (int32 TargetIndex = 0; !bExcluded && TargetIndex < Context.Targets.Num(); ++TargetIndex)
+					{
+						if (Context.Targets[TargetIndex] && ObjectClass->IsChildOf(Context.Targets[TargetIndex]))
+						{
+							Membership->Add(TargetIndex);
+						}
+					}
+				}
+				LastClass = ObjectClass;
+				LastMembership = Membership;
+			}
+			return *LastMembership;
+		}
+
+	private:
+		const FContext& Context;
+		TMap<const UClass*, TArray<int32, TInlineAllocator<2>>> MembershipByClass;
+		const UClass* LastClass;
+		const TArray<int32, TInlineAllocator<2>>* LastMembership;
+	};
+
+	/** 解析请求中的弱引用，返回目标类中是否包含 UObject */
+	static bool ResolveContext(const FObjRefSearchRequest& Request, const FObjRefJobToken& CancelToken, FContext& OutContext)
+	{
+		OutContext.Query = &Request.Query;
+		OutContext.CancelToken = &CancelToken;
+		OutContext.ActorTargets.Init(false, Request.TargetClasses.Num());
+
+		bool bHasObjectTarget = false;
+		for (int32 TargetIndex = 0; TargetIndex < Request.TargetClasses.Num(); ++TargetIndex)
+		{
+			UClass* TargetClass = Request.TargetClasses[TargetIndex].Get();
+			OutContext.Targets.Add(TargetClass);
+			if (TargetClass)
+			{
+				OutContext.ActorTargets[TargetIndex] = TargetClass->IsChildOf(AActor::StaticClass());
+				bHasObjectTarget |= TargetClass == UObject::StaticClass();
+			}
+		}
+		for (const TWeakObjectPtr<UClass>& ExcludedClass : Request.ExcludedClasses)
+		{
+			if (ExcludedClass.IsValid())
+			{
+				OutContext.ExcludedClasses.Add(ExcludedClass.Get());
+			}
+		}
+		for (const TWeakObjectPtr<UWorld>& World : Request.Worlds)
+		{
+			if (World.IsValid())
+			{
+				OutContext.Worlds.Add(World.Get());
+			}
+		}
+		return bHasObjectTarget;
+	}
+
+	/** 检查对象数组中的一项，匹配时写入结果 */
+	static bool SweepObject(const FContext& Context, FClassMembership& Membership, int32 ObjectIndex, FObjRefSearchMatch& OutMatch)
+	{
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+		if (!ObjectItem || !ObjectItem->Object || ObjectItem->IsUnreachable() || ObjectItem->IsPendingKill())
+		{
+			return false;
+		}
+
+		UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+		TArrayView<const int32> TargetIndices = Membership.Get(Object->GetClass());
+		return TargetIndices.Num() > 0 && FilterCandidate(Context, Object, ObjectIndex, TargetIndices, OutMatch);
+	}
+
+	/** 按索引区间扫描整个对象数组，每个对象按所属类的成员位集一次性匹配所有目标类 */
+	static void SweepObjectArray(const FContext& Context, TArray<FObjRefSearchMatch>& OutMatches)
+	{
+		const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumObjects, FObjRefInstanceSearch::ObjectsPerChunk);
+
+		TArray<TArray<FObjRefSearchMatch>> ChunkMatches;
+		ChunkMatches.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&Context, &ChunkMatches, NumObjects](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * FObjRefInstanceSearch::ObjectsPerChunk;
+			const int32 End = FMath::Min(Begin + FObjRefInstanceSearch::ObjectsPerChunk, NumObjects);
+			if (Context.CancelToken->IsCancelled())
+			{
+				return;
+			}
+
+			// 每个分块各自缓存类成员关系，无需加锁
+			FClassMembership Membership(Context);
+			TArray<FObjRefSearchMatch>& Matches = ChunkMatches[ChunkIndex];
+			FObjRefSearchMatch Match;
+
+			for (int32 ObjectIndex = Begin; ObjectIndex < End; ++ObjectIndex)
+			{
+				if (SweepObject(Context, Membership, ObjectIndex, Match))
+				{
+					Matches.Add(MoveTemp(Match));
+				}
+			}
+		});
+
+		for (TArray<FObjRefSearchMatch>& Matches : ChunkMatches)
+		{
+			OutMatches.Append(MoveTemp(Matches));
+		}
+	}
+
+	/** 通过类哈希收集候选对象，按对象索引排序后分块并行过滤 */
+	static void FilterClassHashCandidates(const FContext& Context, TArray<FObjRefSearchMatch>& OutMatches)
+	{
+		TArray<FCandidate> Candidates;
+		TArray<UObject*> ClassObjects;
+		for (int32 TargetIndex = 0; TargetIndex < Context.Targets.Num(); ++TargetIndex)
+		{
+			if (!Context.Targets[TargetIndex])
+			{
+				continue;
+			}
+			if (Context.CancelToken->IsCancelled())
+			{
+				return;
+			}
+
+			ClassObjects.Reset();
+			GetObjectsOfClass(Context.Targets[TargetIndex], ClassObjects, true, RF_ClassDefaultObject, EInternalObjectFlags::PendingKill);
+			for (UObject* Object : ClassObjects)
+			{
+				Candidates.Add({ GUObjectArray.ObjectToIndex(Object), TargetIndex });
+			}
+		}
+
+		// 同一对象被多个目标类命中时排在一起，合并后每个对象只产生一项
+		Algo::SortBy(Candidates, [](const FCandidate& Candidate) { return Candidate.ObjectIndex; });
+
+		TArray<int32> GroupStarts;
+		for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+		{
+			if (CandidateIndex == 0 || Candidates[CandidateIndex].ObjectIndex != Candidates[CandidateIndex - 1].ObjectIndex)
+			{
+				GroupStarts.Add(CandidateIndex);
+			}
+		}
+		GroupStarts.Add(Candidates.Num());
+
+		const int32 NumGroups = GroupStarts.Num() - 1;
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumGroups, FObjRefInstanceSearch::CandidatesPerChunk);
+
+		TArray<TArray<FObjRefSearchMatch>> ChunkMatches;
+		ChunkMatches.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&Context, &Candidates, &GroupStarts, &ChunkMatches, NumGroups](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * FObjRefInstanceSearch::CandidatesPerChunk;
+			const int32 End = FMath::Min(Begin + FObjRefInstanceSearch::CandidatesPerChunk, NumGroups);
+			if (Context.CancelToken->IsCancelled())
+			{
+				return;
+			}
+
+			TArray<FObjRefSearchMatch>& Matches = ChunkMatches[ChunkIndex];
+			FObjRefSearchMatch Match;
+			TArray<int32, TInlineAllocator<4>> TargetIndices;
+			FClassMembership Membership(Context);
+
+			for (int32 GroupIndex = Begin; GroupIndex < End; ++GroupIndex)
+			{
+				const int32 ObjectIndex = Candidates[GroupStarts[GroupIndex]].ObjectIndex;
+				FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+				if (!ObjectItem || !ObjectItem->Object || ObjectItem->IsUnreachable())
+				{
+					continue;
+				}
+
+				// 类哈希按目标类收集，属于排除类的对象在这里去掉
+				UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+				if (Context.ExcludedClasses.Num() > 0 && Membership.Get(Object->GetClass()).Num() == 0)
+				{
+					continue;
+				}
+
+				TargetIndices.Reset();
+				for (int32 CandidateIndex = GroupStarts[GroupIndex]; CandidateIndex < GroupStarts[GroupIndex + 1]; ++CandidateIndex)
+				{
+					TargetIndices.Add(Candidates[CandidateIndex].TargetIndex);
+				}
+
+				if (FilterCandidate(Context, Object, ObjectIndex, TargetIndices, Match))
+				{
+					Matches.Add(MoveTemp(Match));
+				}
+			}
+		});
+
+		for (TArray<FObjRefSearchMatch>& Matches : ChunkMatches)
+		{
+			OutMatches.Append(MoveTemp(Matches));
+		}
+	}
+
+	/** 通过 Outer 哈希或包哈希收集查询范围内对象的索引，按对象索引升序，代价只与范围内的对象数有关 */
+	static void CollectScopeCandidates(UObject* Scope, EObjRefQuerySource Source, TArray<int32>& OutCandidates)
+	{
+		// outer: 只需要直接子对象；within: 逐层收集嵌套对象，范围是包时直接取包哈希；package: 需要包内的所有对象
+		TArray<UObject*> ScopeObjects;
+		UPackage* Package = Cast<UPackage>(Scope);
+		if (Package && (Source == EObjRefQuerySource::Package || Source == EObjRefQuerySource::OuterTree))
+		{
+			GetObjectsWithPackage(Package, ScopeObjects, true, RF_ClassDefaultObject, EInternalObjectFlags::PendingKill);
+		}
+		else
+		{
+			GetObjectsWithOuter(Scope, ScopeObjects, Source == EObjRefQuerySource::OuterTree, RF_ClassDefaultObject, EInternalObjectFlags::PendingKill);
+		}
+
+		OutCandidates.Reset(ScopeObjects.Num());
+		for (UObject* Object : ScopeObjects)
+		{
+			OutCandidates.Add(GUObjectArray.ObjectToIndex(Object));
+		}
+		Algo::Sort(OutCandidates);
+	}
+
+	/** 只枚举查询范围内的对象，分块并行过滤 */
+	static void FilterScopedCandidates(const FContext& Context, UObject* Scope, EObjRefQuerySource Source, TArray<FObjRefSearchMatch>& OutMatches)
+	{
+		TArray<int32> Candidates;
+		CollectScopeCandidates(Scope, Source, Candidates);
+
+		const int32 NumChunks = FMath::DivideAndRoundUp(Candidates.Num(), FObjRefInstanceSearch::CandidatesPerChunk);
+
+		TArray<TArray<FObjRefSearchMatch>> ChunkMatches;
+		ChunkMatches.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&Context, &Candidates, &ChunkMatches](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * FObjRefInstanceSearch::CandidatesPerChunk;
+			const int32 End = FMath::Min(Begin + FObjRefInstanceSearch::CandidatesPerChunk, Candidates.Num());
+			if (Context.CancelToken->IsCancelled())
+			{
+				return;
+			}
+
+			FClassMembership Membership(Context);
+			TArray<FObjRefSearchMatch>& Matches = ChunkMatches[ChunkIndex];
+			FObjRefSearchMatch Match;
+
+			for (int32 CandidateIndex = Begin; CandidateIndex < End; ++CandidateIndex)
+			{
+				if (SweepObject(Context, Membership, Candidates[CandidateIndex], Match))
+				{
+					Matches.Add(MoveTemp(Match));
+				}
+			}
+		});
+
+		for (TArray<FObjRefSearchMatch>& Matches : ChunkMatches)
+		{
+			OutMatches.Append(MoveTemp(Matches));
+		}
+	}
+}
+
+bool FObjRefInstanceSearch::Run(const FObjRefSearchRequest& Request, TArray<FObjRefSearchMatch>& OutMatches, const FObjRefJobToken& CancelToken)
+{
+	using namespace ObjRefInstanceSearch;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutMatches.Reset();
+
+	// 搜索期间阻止GC，对象数组中的对象和类哈希都保持稳定
+	FGCScopeGuard GCGuard;
+
+	FContext Context;
+	const bool bNeedsSweep = ResolveContext(Request, CancelToken, Context);
+
+	FObjRefWorldCache WorldCache;
+	WorldCache.Reset();
+	Context.WorldCache = &WorldCache;
+
+	// 查询范围内的对象通常远少于目标类的实例，优先由 Outer 或包哈希枚举候选
+	UObject* Scope = Request.CandidateScope.Get();
+	const TCHAR* SourceName = nullptr;
+	if (Scope)
+	{
+		const EObjRefQuerySource Source = Request.Query.GetSource();
+		FilterScopedCandidates(Context, Scope, Source, OutMatches);
+		SourceName = Source == EObjRefQuerySource::Package ? TEXT("包哈希查找") :
+			(Source == EObjRefQuerySource::OuterTree ? TEXT("Outer 树查找") : TEXT("Outer 哈希查找"));
+	}
+	// 目标包含 UObject 时整个堆都会命中，逐个类桶收集反而比顺序扫描更慢
+	else if (bNeedsSweep)
+	{
+		SweepObjectArray(Context, OutMatches);
+		SourceName = TEXT("扫描对象数组");
+	}
+	else
+	{
+		FilterClassHashCandidates(Context, OutMatches);
+		SourceName = TEXT("类哈希查找");
+	}
+
+	if (CancelToken.IsCancelled())
+	{
+		UE_LOG(LogTemp, Log, TEXT("并行实例搜索已取消，用时 %.3f 秒"), FPlatformTime::Seconds() - StartTime);
+		OutMatches.Reset();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("并行实例搜索完成: %d 个目标类, %s, 找到 %d 个实例, 用时 %.3f 秒"),
+		Context.Targets.Num(), SourceName,
+		OutMatches.Num(), FPlatformTime::Seconds() - StartTime);
+	return true;
+}
+
+FObjRefTimeSlicedSearch::FObjRefTimeSlicedSearch(const FObjRefSearchRequest& InRequest)
+	: Request(InRequest)
+	, NextObjectIndex(0)
+	, bHasScope(false)
+	, bIsComplete(false)
+{
+	// 有查询范围时只逐帧检查范围内的对象；候选在开始时收集一次，之后在范围内新建的对象不会被扫描到
+	if (UObject* Scope = Request.CandidateScope.Get())
+	{
+		ObjRefInstanceSearch::CollectScopeCandidates(Scope, Request.Query.GetSource(), ScopeCandidates);
+		bHasScope = true;
+	}
+
+	WorldCache.Reset();
+}
+
+void FObjRefTimeSlicedSearch::OnGarbageCollected()
+{
+	// 被回收的 Outer 的槽位可能已被新对象复用
+	WorldCache.Reset();
+}
+
+bool FObjRefTimeSlicedSearch::Step(double BudgetSeconds, TArray<FObjRefSearchMatch>& OutNewMatches)
+{
+	using namespace ObjRefInstanceSearch;
+
+	check(IsInGameThread());
+
+	if (bIsComplete)
+	{
+		return true;
+	}
+
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+	// 两帧之间可能发生GC，目标类和世界每帧重新解析，类成员缓存也只在本帧内有效
+	FContext Context;
+	const FObjRefJobToken NeverCancelled;
+	ResolveContext(Request, NeverCancelled, Context);
+	Context.WorldCache = &WorldCache;
+	FClassMembership Membership(Context);
+	FObjRefSearchMatch Match;
+
+	while (!bIsComplete)
+	{
+		// 对象数组在搜索期间可能增长，新创建的对象也会被扫描到；有查询范围时游标指向候选列表。
+		// 两帧之间的GC可能让候选槽位被新对象复用，谓词链中的范围条件会再次检查
+		const int32 NumObjects = bHasScope ? ScopeCandidates.Num() : GUObjectArray.GetObjectArrayNum();
+		const int32 End = FMath::Min(NextObjectIndex + ObjectsPerTimeCheck, NumObjects);
+		for (; NextObjectIndex < End; ++NextObjectIndex)
+		{
+			const int32 ObjectIndex = bHasScope ? ScopeCandidates[NextObjectIndex] : NextObjectIndex;
+			if (SweepObject(Context, Membership, ObjectIndex, Match))
+			{
+				OutNewMatches.Add(MoveTemp(Match));
+			}
+		}
+
+		bIsComplete = NextObjectIndex >= NumObjects;
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	return bIsComplete;
+}
+
+float FObjRefTimeSlicedSearch::GetProgress() const
+{
+	if (bIsComplete)
+	{
+		return 1.0f;
+	}
+	const int32 NumObjects = bHasScope ? ScopeCandidates.Num() : GUObjectArray.GetObjectArrayNum();
+	return NumObjects > 0 ? FMath::Clamp(static_cast<float>(NextObjectIndex) / NumObjects, 0.0f, 1.0f) : 0.0f;
+}
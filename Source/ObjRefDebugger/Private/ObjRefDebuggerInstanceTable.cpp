@@ -0,0 +1,432 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerInstanceSearch.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "UObject/UObjectArray.h"
+#include "Engine/World.h"
+#include "Algo/BinarySearch.h"
+
+/** 按新的行顺序重排一列 */
+template<typename ElementType>
+static void PermuteColumn(TArray<ElementType>& Column, const TArray<int32>& Order)
+{
+	TArray<ElementType> Sorted;
+	Sorted.SetNumUninitialized(Order.Num());
+	for (int32 Row = 0; Row < Order.Num(); ++Row)
+	{
+		Sorted[Row] = Column[Order[Row]];
+	}
+	Column = MoveTemp(Sorted);
+}
+
+FObjRefInstanceTable::FObjRefInstanceTable(const TArray<FName>& InTargetClassNames)
+	: bHasExclusiveSizes(false)
+	, bHasReferenceCounts(false)
+	, TargetClassNames(InTargetClassNames)
+{
+	// 世界ID 0 固定表示无世界
+	WorldNames.Add(TEXT("无世界"));
+}
+
+void FObjRefInstanceTable::Append(const TArray<FObjRefSearchMatch>& Matches)
+{
+	const int32 FirstNewRow = Num();
+	const int32 ExpectedRows = FirstNewRow + Matches.Num();
+	ObjectIndices.Reserve(ExpectedRows);
+	SerialNumbers.Reserve(ExpectedRows);
+	ClassIds.Reserve(ExpectedRows);
+	WorldIds.Reserve(ExpectedRows);
+	MatchedTargets.Reserve(ExpectedRows);
+	MemorySizes.Reserve(ExpectedRows);
+	RetainedSizes.Reserve(ExpectedRows);
+	ReferenceCounts.Reserve(ExpectedRows);
+	Flags.Reserve(ExpectedRows);
+
+	for (const FObjRefSearchMatch& Match : Matches)
+	{
+		UObject* Object = Match.Object.Get();
+		if (!Object)
+		{
+			continue;
+		}
+
+		const int32 ClassId = InternClass(Object->GetClass());
+
+		// 目标类超过32个时只记录前32个
+		uint32 TargetMask = 0;
+		for (int32 TargetIndex : Match.MatchedTargets)
+		{
+			if (TargetIndex < 32)
+			{
+				TargetMask |= 1u << TargetIndex;
+			}
+		}
+
+		ObjectIndices.Add(Match.ObjectIndex);
+		SerialNumbers.Add(GUObjectArray.AllocateSerialNumber(Match.ObjectIndex));
+		ClassIds.Add(ClassId);
+		WorldIds.Add(InternWorld(Object, Match.WorldIndex));
+		MatchedTargets.Add(TargetMask);
+		MemorySizes.Add(ClassStructureSizes[ClassId]);
+		RetainedSizes.Add(INDEX_NONE);
+		ReferenceCounts.Add(0);
+		Flags.Add(GetObjectFlags(Object));
+	}
+
+	// 追加的行不再带有独占内存与引用者数量，需要重新统计
+	bHasExclusiveSizes = bHasExclusiveSizes && FirstNewRow == Num();
+	bHasReferenceCounts = bHasReferenceCounts && FirstNewRow == Num();
+
+	// 搜索结果本身按对象索引排列，只有追加的区间与已有的行交错时才需要重新排序
+	if (FirstNewRow > 0 && FirstNewRow < Num() && ObjectIndices[FirstNewRow] <= ObjectIndices[FirstNewRow - 1])
+	{
+		SortByObjectIndex();
+	}
+}
+
+void FObjRefInstanceTable::AppendHandles(TArray<TWeakObjectPtr<UObject>>& OutHandles, int32 FirstRow) const
+{
+	OutHandles.Reserve(OutHandles.Num() + FMath::Max(Num() - FirstRow, 0));
+	for (int32 Row = FirstRow; Row < Num(); ++Row)
+	{
+		if (UObject* Object = ResolveRow(Row))
+		{
+			OutHandles.Add(Object);
+		}
+	}
+}
+
+void FObjRefInstanceTable::AppendHandles(TArray<TWeakObjectPtr<UObject>>& OutHandles, TArrayView<const int32> RowOrder) const
+{
+	OutHandles.Reserve(OutHandles.Num() + RowOrder.Num());
+	for (int32 Row : RowOrder)
+	{
+		if (UObject* Object = ResolveRow(Row))
+		{
+			OutHandles.Add(Object);
+		}
+	}
+}
+
+void FObjRefInstanceTable::Diff(const FObjRefInstanceTable& OldTable, const FObjRefInstanceTable& NewTable, FObjRefTableDiff& OutDiff)
+{
+	OutDiff.AddedRows.Reset();
+	OutDiff.RemovedRows.Reset();
+	OutDiff.NumUnchanged = 0;
+
+	int32 OldRow = 0;
+	int32 NewRow = 0;
+	while (OldRow < OldTable.Num() && NewRow < NewTable.Num())
+	{
+		const int32 OldIndex = OldTable.ObjectIndices[OldRow];
+		const int32 NewIndex = NewTable.ObjectIndices[NewRow];
+		if (OldIndex < NewIndex)
+		{
+			OutDiff.RemovedRows.Add(OldRow++);
+		}
+		else if (NewIndex < OldIndex)
+		{
+			OutDiff.AddedRows.Add(NewRow++);
+		}
+		else
+		{
+			if (OldTable.SerialNumbers[OldRow] == NewTable.SerialNumbers[NewRow])
+			{
+				++OutDiff.NumUnchanged;
+			}
+			else
+			{
+				OutDiff.RemovedRows.Add(OldRow);
+				OutDiff.AddedRows.Add(NewRow);
+			}
+			++OldRow;
+			++NewRow;
+		}
+	}
+
+	for (; OldRow < OldTable.Num(); ++OldRow)
+	{
+		OutDiff.RemovedRows.Add(OldRow);
+	}
+	for (; NewRow < NewTable.Num(); ++NewRow)
+	{
+		OutDiff.AddedRows.Add(NewRow);
+	}
+}
+
+int32 FObjRefInstanceTable::RemoveStaleRows()
+{
+	return RemoveRowsIf([this](int32 Row) { return !ResolveRow(Row); });
+}
+
+int32 FObjRefInstanceTable::RemoveRowsIf(TFunctionRef<bool(int32 Row)> ShouldRemove)
+{
+	// 一次遍历把保留的行前移，所有列同步压缩；谓词读取的行总在写入位置之后，尚未被覆盖
+	int32 WriteRow = 0;
+	for (int32 Row = 0; Row < Num(); ++Row)
+	{
+		if (ShouldRemove(Row))
+		{
+			continue;
+		}
+		if (WriteRow != Row)
+		{
+			ObjectIndices[WriteRow] = ObjectIndices[Row];
+			SerialNumbers[WriteRow] = SerialNumbers[Row];
+			ClassIds[WriteRow] = ClassIds[Row];
+			WorldIds[WriteRow] = WorldIds[Row];
+			MatchedTargets[WriteRow] = MatchedTargets[Row];
+			MemorySizes[WriteRow] = MemorySizes[Row];
+			RetainedSizes[WriteRow] = RetainedSizes[Row];
+			ReferenceCounts[WriteRow] = ReferenceCounts[Row];
+			Flags[WriteRow] = Flags[Row];
+		}
+		++WriteRow;
+	}
+
+	const int32 NumRemoved = Num() - WriteRow;
+	ObjectIndices.SetNum(WriteRow, false);
+	SerialNumbers.SetNum(WriteRow, false);
+	ClassIds.SetNum(WriteRow, false);
+	WorldIds.SetNum(WriteRow, false);
+	MatchedTargets.SetNum(WriteRow, false);
+	MemorySizes.SetNum(WriteRow, false);
+	RetainedSizes.SetNum(WriteRow, false);
+	ReferenceCounts.SetNum(WriteRow, false);
+	Flags.SetNum(WriteRow, false);
+	return NumRemoved;
+}
+
+int32 FObjRefInstanceTable::FindRow(const UObject* Object) const
+{
+	if (!Object)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+	const int32 Row = Algo::BinarySearch(ObjectIndices, ObjectIndex);
+	if (Row == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// 槽位被复用后序列号不同，旧行不属于这个对象
+	const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+	return ObjectItem && ObjectItem->GetSerialNumber() == SerialNumbers[Row] ? Row : INDEX_NONE;
+}
+
+UObject* FObjRefInstanceTable::ResolveRow(int32 Row) const
+{
+	const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndices[Row]);
+	if (!ObjectItem || !ObjectItem->Object || ObjectItem->IsUnreachable() || ObjectItem->GetSerialNumber() != SerialNumbers[Row])
+	{
+		return nullptr;
+	}
+	return static_cast<UObject*>(ObjectItem->Object);
+}
+
+FString FObjRefInstanceTable::GetMatchedClassNames(int32 Row) const
+{
+	TArray<FString> MatchedNames;
+	for (int32 TargetIndex = 0; TargetIndex < TargetClassNames.Num() && TargetIndex < 32; ++TargetIndex)
+	{
+		if (MatchedTargets[Row] & (1u << TargetIndex))
+		{
+			MatchedNames.Add(TargetClassNames[TargetIndex].ToString());
+		}
+	}
+	return FString::Join(MatchedNames, TEXT(", "));
+}
+
+void FObjRefInstanceTable::SetExclusiveSizes(const TArray<int64>& Sizes)
+{
+	check(Sizes.Num() == Num());
+	for (int32 Row = 0; Row < Num(); ++Row)
+	{
+		// 统计失败的对象保留结构体大小
+		if (Sizes[Row] >= 0)
+		{
+			MemorySizes[Row] = Sizes[Row];
+		}
+	}
+	bHasExclusiveSizes = true;
+}
+
+void FObjRefInstanceTable::UpdateReferenceColumns(const FObjRefReferenceGraph& Graph)
+{
+	// 反向边按属性记录，Actor 通过 RootComponent、OwnedComponents 等多个属性引用同一组件时有多条边；
+	// 按引用者对象索引记录最后计入它的行（行号 + 1），每个引用者在每行只计一次，无需逐行清零
+	TArray<int32> LastCountedRow;
+	LastCountedRow.SetNumZeroed(GUObjectArray.GetObjectArrayNum());
+
+	for (int32 Row = 0; Row < Num(); ++Row)
+	{
+		int32 ReferenceCount = 0;
+		const int32 RowStamp = Row + 1;
+		Graph.ForEachReferencer(ObjectIndices[Row], [&ReferenceCount, &LastCountedRow, RowStamp](int32 SourceIndex, int32 PropertyId)
+		{
+			if (!LastCountedRow.IsValidIndex(SourceIndex))
+			{
+				LastCountedRow.SetNumZeroed(SourceIndex + 1);
+			}
+			if (LastCountedRow[SourceIndex] != RowStamp)
+			{
+				LastCountedRow[SourceIndex] = RowStamp;
+				++ReferenceCount;
+			}
+		});
+		ReferenceCounts[Row] = ReferenceCount;
+
+		if (Graph.GetRootKind(ObjectIndices[Row]) != EObjRefRootKind::None)
+		{
+			Flags[Row] |= EObjRefRowFlags::GCRoot;
+		}
+		else
+		{
+			Flags[Row] &= ~EObjRefRowFlags::GCRoot;
+		}
+	}
+	bHasReferenceCounts = true;
+}
+
+EObjRefRowFlags FObjRefInstanceTable::GetObjectFlags(const UObject* Object)
+{
+	EObjRefRowFlags RowFlags = EObjRefRowFlags::None;
+	if (Object->IsRooted())
+	{
+		RowFlags |= EObjRefRowFlags::RootSet;
+	}
+	if (Object->HasAnyFlags(RF_Standalone))
+	{
+		RowFlags |= EObjRefRowFlags::Standalone;
+	}
+	if (Object->HasAnyFlags(RF_Transient))
+	{
+		RowFlags |= EObjRefRowFlags::Transient;
+	}
+	return RowFlags;
+}
+
+SIZE_T FObjRefInstanceTable::GetAllocatedSize() const
+{
+	SIZE_T Size = ObjectIndices.GetAllocatedSize() + SerialNumbers.GetAllocatedSize() + ClassIds.GetAllocatedSize()
+		+ WorldIds.GetAllocatedSize() + MatchedTargets.GetAllocatedSize() + MemorySizes.GetAllocatedSize()
+		+ RetainedSizes.GetAllocatedSize() + ReferenceCounts.GetAllocatedSize() + Flags.GetAllocatedSize()
+		+ ClassNames.GetAllocatedSize() + ClassStructureSizes.GetAllocatedSize() + ClassIdByObjectIndex.GetAllocatedSize()
+		+ WorldNames.GetAllocatedSize() + WorldIdByObjectIndex.GetAllocatedSize() + TargetClassNames.GetAllocatedSize();
+	for (const FString& Name : ClassNames)
+	{
+		Size += Name.GetAllocatedSize();
+	}
+	for (const FString& Name : WorldNames)
+	{
+		Size += Name.GetAllocatedSize();
+	}
+	return Size;
+}
+
+int32 FObjRefInstanceTable::InternClass(UClass* Class)
+{
+	const int32 ClassObjectIndex = GUObjectArray.ObjectToIndex(Class);
+	if (const int32* ExistingId = ClassIdByObjectIndex.Find(ClassObjectIndex))
+	{
+		return *ExistingId;
+	}
+
+	const int32 ClassId = ClassNames.Add(Class->GetName());
+	ClassStructureSizes.Add(Class->GetStructureSize());
+	ClassIdByObjectIndex.Add(ClassObjectIndex, ClassId);
+	return ClassId;
+}
+
+int32 FObjRefInstanceTable::InternWorld(UObject* Object, int32 WorldIndex)
+{
+	if (WorldIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// 搜索结果交给结果表之前可能发生了GC，槽位中已不是世界时按对象重新解析
+	UWorld* World = nullptr;
+	FUObjectItem* WorldItem = GUObjectArray.IndexToObject(WorldIndex);
+	UObject* WorldObject = WorldItem ? static_cast<UObject*>(WorldItem->Object) : nullptr;
+	if (WorldObject && WorldObject->GetClass()->HasAnyCastFlag(CASTCLASS_UWorld))
+	{
+		World = static_cast<UWorld*>(WorldObject);
+	}
+	else
+	{
+		World = Object->GetWorld();
+	}
+
+	if (!World)
+	{
+		return 0;
+	}
+
+	const int32 WorldObjectIndex = GUObjectArray.ObjectToIndex(World);
+	if (const int32* ExistingId = WorldIdByObjectIndex.Find(WorldObjectIndex))
+	{
+		return *ExistingId;
+	}
+
+	const int32 WorldId = WorldNames.Add(World->GetName());
+	WorldIdByObjectIndex.Add(WorldObjectIndex, WorldId);
+	return WorldId;
+}
+
+void FObjRefInstanceTable::SortByObjectIndex()
+{
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Num());
+	for (int32 Row = 0; Row < Num(); ++Row)
+	{
+		Order[Row] = Row;
+	}
+	Algo::SortBy(Order, [this](int32 Row) { return ObjectIndices[Row]; });
+
+	PermuteColumn(ObjectIndices, Order);
+	PermuteColumn(SerialNumbers, Order);
+	PermuteColumn(ClassIds, Order);
+	PermuteColumn(WorldIds, Order);
+	PermuteColumn(MatchedTargets, Order);
+	PermuteColumn(MemorySizes, Order);
+	PermuteColumn(RetainedSizes, Order);
+	PermuteColumn(ReferenceCounts, Order);
+	PermuteColumn(Flags, Order);
+}
+
+const FText* FObjRefRowTextCache::FindObjectName(int32 ObjectIndex, int32 SerialNumber) const
+{
+	const FObjRefRowText* Text = Entries.Find(ObjectIndex);
+	return Text && Text->SerialNumber == SerialNumber ? &Text->ObjectName : nullptr;
+}
+
+const FText& FObjRefRowTextCache::GetObjectName(const FObjRefInstanceTable& Table, int32 Row)
+{
+	const int32 ObjectIndex = Table.GetObjectIndices()[Row];
+	const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+	const int32 SerialNumber = ObjectItem ? ObjectItem->GetSerialNumber() : 0;
+
+	FObjRefRowText* Text = Entries.Find(ObjectIndex);
+	if (Text && Text->SerialNumber == SerialNumber)
+	{
+		return Text->ObjectName;
+	}
+
+	if (!Text)
+	{
+		if (Entries.Num() >= MaxEntries)
+		{
+			Entries.Reset();
+		}
+		Text = &Entries.Add(ObjectIndex);
+	}
+
+	Text->SerialNumber = SerialNumber;
+	UObject* Object = Table.ResolveRow(Row);
+	Text->ObjectName = FText::FromString(Object ? Object->GetName() : TEXT("已被回收"));
+	return Text->ObjectName;
+}
@@ -0,0 +1,345 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerInstanceView.h"
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerParallelSort.h"
+#include "ObjRefDebuggerTrigramIndex.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** 排序键与行号，键相同时按行号（即对象索引）排列，结果是确定的 */
+	struct FSortEntry
+	{
+		int64 Key;
+		int32 Row;
+	};
+
+	/** 每个过滤任务检查的行数 */
+	const int32 RowsPerFilterTask = 4096;
+
+	/** 按名称排序名称表，返回每个名称ID的排名 */
+	TArray<int32> MakeNameRanks(const TArray<FString>& Names)
+	{
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Names.Num());
+		for (int32 NameId = 0; NameId < Names.Num(); ++NameId)
+		{
+			Order[NameId] = NameId;
+		}
+		Algo::Sort(Order, [&Names](int32 A, int32 B) { return Names[A] < Names[B]; });
+
+		TArray<int32> Ranks;
+		Ranks.SetNumUninitialized(Names.Num());
+		for (int32 Rank = 0; Rank < Order.Num(); ++Rank)
+		{
+			Ranks[Order[Rank]] = Rank;
+		}
+		return Ranks;
+	}
+
+	/** 名称表中每个名称是否匹配已解析的过滤文本 */
+	TArray<uint8> MatchNames(const TArray<FString>& Names, const FString& LowerText, bool bPrefix)
+	{
+		TArray<uint8> Matches;
+		Matches.SetNumUninitialized(Names.Num());
+		for (int32 NameId = 0; NameId < Names.Num(); ++NameId)
+		{
+			Matches[NameId] = (bPrefix ? Names[NameId].StartsWith(LowerText) : Names[NameId].Contains(LowerText)) ? 1 : 0;
+		}
+		return Matches;
+	}
+}
+
+FObjRefInstanceView::FObjRefInstanceView()
+	: SortColumn(EObjRefInstanceColumn::Name)
+	, SortMode(EColumnSortMode::None)
+{
+}
+
+void FObjRefInstanceView::SetTable(TSharedPtr<FObjRefInstanceTable> InTable)
+{
+	Table = InTable;
+	Refresh();
+}
+
+void FObjRefInstanceView::Refresh()
+{
+	NameSortKeys.Reset();
+	NameIndex.Invalidate();
+	SortedRows.Reset();
+	RowPassesFilter.Reset();
+	VisibleRows.Reset();
+	if (!Table.IsValid())
+	{
+		return;
+	}
+
+	SortRows();
+	FilterRows(0, false);
+	RebuildVisibleRows();
+}
+
+int32 FObjRefInstanceView::AppendRows(int32 FirstNewRow)
+{
+	NameSortKeys.Reset();
+	NameIndex.Invalidate();
+
+	const int32 FirstVisibleRow = VisibleRows.Num();
+	FilterRows(FirstNewRow, false);
+	for (int32 Row = FirstNewRow; Row < Table->Num(); ++Row)
+	{
+		SortedRows.Add(Row);
+		if (RowPassesFilter[Row])
+		{
+			VisibleRows.Add(Row);
+		}
+	}
+	return FirstVisibleRow;
+}
+
+void FObjRefInstanceView::SetSort(EObjRefInstanceColumn Column, EColumnSortMode::Type Mode)
+{
+	SortColumn = Column;
+	SortMode = Mode;
+	if (Table.IsValid())
+	{
+		SortRows();
+		RebuildVisibleRows();
+	}
+}
+
+EColumnSortMode::Type FObjRefInstanceView::GetSortMode(EObjRefInstanceColumn Column) const
+{
+	return Column == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void FObjRefInstanceView::SetFilterText(const FString& InFilterText)
+{
+	// 新文本包含旧文本时，未通过旧过滤的行也不可能通过新过滤；前缀查询只能由更长的前缀细化
+	const bool bRefine = !FilterText.IsEmpty() &&
+		(FilterText.StartsWith(TEXT("^")) ? InFilterText.StartsWith(FilterText) : InFilterText.Contains(FilterText));
+	FilterText = InFilterText;
+	if (Table.IsValid())
+	{
+		FilterRows(0, bRefine);
+		RebuildVisibleRows();
+	}
+}
+
+FName FObjRefInstanceView::GetColumnId(EObjRefInstanceColumn Column)
+{
+	static const FName ColumnIds[] =
+	{
+		TEXT("Name"),
+		TEXT("Class"),
+		TEXT("World"),
+		TEXT("MemorySize"),
+		TEXT("ReferenceCount"),
+		TEXT("RetainedSize"),
+	};
+	return ColumnIds[static_cast<int32>(Column)];
+}
+
+bool FObjRefInstanceView::FindColumn(const FName& ColumnId, EObjRefInstanceColumn& OutColumn)
+{
+	for (int32 ColumnIndex = 0; ColumnIndex <= static_cast<int32>(EObjRefInstanceColumn::RetainedSize); ++ColumnIndex)
+	{
+		if (GetColumnId(static_cast<EObjRefInstanceColumn>(ColumnIndex)) == ColumnId)
+		{
+			OutColumn = static_cast<EObjRefInstanceColumn>(ColumnIndex);
+			return true;
+		}
+	}
+	return false;
+}
+
+void FObjRefInstanceView::SortRows()
+{
+	const int32 NumRows = Table->Num();
+	SortedRows.SetNumUninitialized(NumRows);
+
+	// 不排序时保持结果表的顺序（对象索引）
+	if (SortMode == EColumnSortMode::None)
+	{
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			SortedRows[Row] = Row;
+		}
+		return;
+	}
+
+	TArray<FSortEntry> Entries;
+	Entries.SetNumUninitialized(NumRows);
+	auto FillKeys = [&Entries, NumRows](auto&& GetKey)
+	{
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			Entries[Row].Key = GetKey(Row);
+			Entries[Row].Row = Row;
+		}
+	};
+
+	switch (SortColumn)
+	{
+	case EObjRefInstanceColumn::Name:
+	{
+		BuildNameSortKeys();
+		FillKeys([this](int32 Row) { return NameSortKeys[Row]; });
+		break;
+	}
+	case EObjRefInstanceColumn::Class:
+	{
+		const TArray<int32> Ranks = MakeNameRanks(Table->GetClassNames());
+		const TArray<int32>& ClassIds = Table->GetClassIds();
+		FillKeys([&Ranks, &ClassIds](int32 Row) { return static_cast<int64>(Ranks[ClassIds[Row]]); });
+		break;
+	}
+	case EObjRefInstanceColumn::World:
+	{
+		const TArray<int32> Ranks = MakeNameRanks(Table->GetWorldNames());
+		const TArray<int32>& WorldIds = Table->GetWorldIds();
+		FillKeys([&Ranks, &WorldIds](int32 Row) { return static_cast<int64>(Ranks[WorldIds[Row]]); });
+		break;
+	}
+	case EObjRefInstanceColumn::MemorySize:
+	{
+		const TArray<int64>& MemorySizes = Table->GetMemorySizes();
+		FillKeys([&MemorySizes](int32 Row) { return MemorySizes[Row]; });
+		break;
+	}
+	case EObjRefInstanceColumn::ReferenceCount:
+	{
+		const TArray<int32>& ReferenceCounts = Table->GetReferenceCounts();
+		FillKeys([&ReferenceCounts](int32 Row) { return static_cast<int64>(ReferenceCounts[Row]); });
+		break;
+	}
+	case EObjRefInstanceColumn::RetainedSize:
+	{
+		const TArray<int64>& RetainedSizes = Table->GetRetainedSizes();
+		FillKeys([&RetainedSizes](int32 Row) { return RetainedSizes[Row]; });
+		break;
+	}
+	}
+
+	const bool bDescending = SortMode == EColumnSortMode::Descending;
+	ObjRefParallelSort(Entries, [bDescending](const FSortEntry& A, const FSortEntry& B)
+	{
+		if (A.Key != B.Key)
+		{
+			return bDescending ? A.Key > B.Key : A.Key < B.Key;
+		}
+		return A.Row < B.Row;
+	});
+
+	for (int32 Index = 0; Index < NumRows; ++Index)
+	{
+		SortedRows[Index] = Entries[Index].Row;
+	}
+}
+
+void FObjRefInstanceView::BuildNameSortKeys()
+{
+	const int32 NumRows = Table->Num();
+	if (NameSortKeys.Num() == NumRows)
+	{
+		return;
+	}
+
+	TArray<FName> Names;
+	Names.SetNum(NumRows);
+	ParallelFor(NumRows, [this, &Names](int32 Row)
+	{
+		UObject* Object = Table->ResolveRow(Row);
+		Names[Row] = Object ? Object->GetFName() : NAME_None;
+	});
+
+	// 同类对象的名称通常共享基础名（BP_Enemy_C_1、BP_Enemy_C_2 ...），
+	// 只对不同的基础名做一次字符串比较，排序键为 基础名排名 << 32 | 数字后缀
+	TMap<FNameEntryId, int32> BaseIdByEntry;
+	TArray<FString> BaseNames;
+	TArray<int32> BaseOfRow;
+	BaseOfRow.SetNumUninitialized(NumRows);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const FNameEntryId EntryId = Names[Row].GetComparisonIndex();
+		const int32* BaseId = BaseIdByEntry.Find(EntryId);
+		BaseOfRow[Row] = BaseId ? *BaseId : BaseIdByEntry.Add(EntryId, BaseNames.Add(Names[Row].GetPlainNameString()));
+	}
+
+	const TArray<int32> Ranks = MakeNameRanks(BaseNames);
+	NameSortKeys.SetNumUninitialized(NumRows);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		NameSortKeys[Row] = (static_cast<int64>(Ranks[BaseOfRow[Row]]) << 32) | static_cast<uint32>(Names[Row].GetNumber());
+	}
+}
+
+void FObjRefInstanceView::FilterRows(int32 FirstRow, bool bRefine)
+{
+	const int32 NumRows = Table->Num();
+	RowPassesFilter.SetNumZeroed(NumRows);
+
+	FString LowerText;
+	bool bPrefix = false;
+	FObjRefNameIndex::ParseQuery(FilterText, LowerText, bPrefix);
+	if (LowerText.IsEmpty())
+	{
+		FMemory::Memset(RowPassesFilter.GetData() + FirstRow, 1, NumRows - FirstRow);
+		return;
+	}
+
+	// 类名和世界名在名称表上各匹配一次
+	const TArray<uint8> ClassMatches = MatchNames(Table->GetClassNames(), LowerText, bPrefix);
+	const TArray<uint8> WorldMatches = MatchNames(Table->GetWorldNames(), LowerText, bPrefix);
+	const TArray<int32>& ClassIds = Table->GetClassIds();
+	const TArray<int32>& WorldIds = Table->GetWorldIds();
+
+	// 对象名称和 Outer 路径通过三元组索引匹配；分帧搜索中追加的新行还没有索引，逐个检查对象
+	const bool bUseIndex = FirstRow == 0;
+	TArray<uint8> NameMatches;
+	if (bUseIndex)
+	{
+		if (!NameIndex.IsUpToDate(NumRows))
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			NameIndex.Build(*Table);
+			UE_LOG(LogTemp, Log, TEXT("建立名称索引 %d 行，用时 %.1f 毫秒，占用 %.1f KB"),
+				NumRows, (FPlatformTime::Seconds() - StartTime) * 1000.0, NameIndex.GetAllocatedSize() / 1024.0);
+		}
+		NameIndex.MatchRows(FilterText, NameMatches);
+	}
+
+	const int32 NumTasks = FMath::DivideAndRoundUp(NumRows - FirstRow, RowsPerFilterTask);
+	ParallelFor(NumTasks, [&, FirstRow, NumRows, bRefine, bUseIndex, bPrefix](int32 TaskIndex)
+	{
+		const int32 TaskFirstRow = FirstRow + TaskIndex * RowsPerFilterTask;
+		const int32 TaskLastRow = FMath::Min(TaskFirstRow + RowsPerFilterTask, NumRows);
+		for (int32 Row = TaskFirstRow; Row < TaskLastRow; ++Row)
+		{
+			if (bRefine && !RowPassesFilter[Row])
+			{
+				continue;
+			}
+
+			bool bPasses = ClassMatches[ClassIds[Row]] || WorldMatches[WorldIds[Row]];
+			if (!bPasses)
+			{
+				bPasses = bUseIndex ? NameMatches[Row] != 0 : FObjRefNameIndex::MatchObject(Table->ResolveRow(Row), LowerText, bPrefix);
+			}
+			RowPassesFilter[Row] = bPasses ? 1 : 0;
+		}
+	});
+}
+
+void FObjRefInstanceView::RebuildVisibleRows()
+{
+	VisibleRows.Reset(SortedRows.Num());
+	for (int32 Row : SortedRows)
+	{
+		if (RowPassesFilter[Row])
+		{
+			VisibleRows.Add(Row);
+		}
+	}
+}
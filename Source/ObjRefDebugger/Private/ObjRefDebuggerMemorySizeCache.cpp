@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerMemorySizeCache.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/ResourceSize.h"
+#include "UObject/GarbageCollection.h"
+#include "Engine/DataAsset.h"
+#include "Async/ParallelFor.h"
+
+FObjRefMemorySizeCache::FObjRefMemorySizeCache()
+	: NumEntriesAfterPrune(0)
+{
+}
+
+void FObjRefMemorySizeCache::Reset()
+{
+	Sizes.Empty();
+	NumEntriesAfterPrune = 0;
+}
+
+int64 FObjRefMemorySizeCache::CountExclusiveSize(UObject* Object)
+{
+	FArchiveCountMem CountMem(Object);
+
+	FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+	Object->GetResourceSizeEx(ResourceSize);
+
+	return static_cast<int64>(Object->GetClass()->GetStructureSize())
+		+ static_cast<int64>(CountMem.GetMax())
+		+ static_cast<int64>(ResourceSize.GetTotalMemoryBytes());
+}
+
+bool FObjRefMemorySizeCache::CanCountInParallel(const UObject* Object)
+{
+	// 只比较最近的原生类本身而不是 IsA：原生子类可能重写 Serialize 或 GetResourceSizeEx，
+	// 蓝图子类不能重写它们，只多出按反射序列化的属性
+	const UClass* NativeClass = Object->GetClass();
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	// 这些类的 Serialize 只做属性的标签序列化，GetResourceSizeEx 使用默认实现，不访问全局状态
+	return NativeClass == UObject::StaticClass()
+		|| NativeClass == UDataAsset::StaticClass()
+		|| NativeClass == UPrimaryDataAsset::StaticClass();
+}
+
+void FObjRefMemorySizeCache::GetExclusiveSizes(const TArray<UObject*>& Objects, TArray<int64>& OutSizes)
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (Sizes.Num() > FMath::Max(NumEntriesAfterPrune * 2, 1024))
+	{
+		PruneStaleEntries();
+	}
+
+	OutSizes.Reset();
+	OutSizes.Init(INDEX_NONE, Objects.Num());
+
+	// 先在游戏线程查缓存，FObjectKey 可能需要为对象分配序列号
+	TArray<int32> ParallelMisses;
+	TArray<int32> GameThreadMisses;
+	TArray<FObjectKey> Keys;
+	Keys.SetNum(Objects.Num());
+
+	for (int32 Index = 0; Index < Objects.Num(); ++Index)
+	{
+		UObject* Object = Objects[Index];
+		if (!IsValid(Object))
+		{
+			continue;
+		}
+
+		Keys[Index] = FObjectKey(Object);
+		if (const int64* CachedSize = Sizes.Find(Keys[Index]))
+		{
+			OutSizes[Index] = *CachedSize;
+		}
+		else if (CanCountInParallel(Object))
+		{
+			ParallelMisses.Add(Index);
+		}
+		else
+		{
+			GameThreadMisses.Add(Index);
+		}
+	}
+
+	if (ParallelMisses.Num() > 0 || GameThreadMisses.Num() > 0)
+	{
+		FGCScopeGuard GCGuard;
+
+		const int32 NumBatches = FMath::DivideAndRoundUp(ParallelMisses.Num(), ObjectsPerBatch);
+		ParallelFor(NumBatches, [&Objects, &ParallelMisses, &OutSizes](int32 BatchIndex)
+		{
+			const int32 Begin = BatchIndex * ObjectsPerBatch;
+			const int32 End = FMath::Min(Begin + ObjectsPerBatch, ParallelMisses.Num());
+			for (int32 MissIndex = Begin; MissIndex < End; ++MissIndex)
+			{
+				const int32 Index = ParallelMisses[MissIndex];
+				OutSizes[Index] = CountExclusiveSize(Objects[Index]);
+			}
+		});
+
+		for (int32 Index : GameThreadMisses)
+		{
+			OutSizes[Index] = CountExclusiveSize(Objects[Index]);
+		}
+	}
+
+	for (int32 Index : ParallelMisses)
+	{
+		Sizes.Add(Keys[Index], OutSizes[Index]);
+	}
+	for (int32 Index : GameThreadMisses)
+	{
+		Sizes.Add(Keys[Index], OutSizes[Index]);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("独占内存统计完成: %d 个对象, 新统计 %d 个, 用时 %.3f 秒"),
+		Objects.Num(), ParallelMisses.Num() + GameThreadMisses.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+void FObjRefMemorySizeCache::PruneStaleEntries()
+{
+	for (auto It = Sizes.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	NumEntriesAfterPrune = Sizes.Num();
+}
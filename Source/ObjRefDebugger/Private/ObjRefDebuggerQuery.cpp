@@ -0,0 +1,671 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerQuery.h"
+#include "ObjRefDebuggerWorldCache.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+#include "Algo/StableSort.h"
+
+#define LOCTEXT_NAMESPACE "ObjRefDebuggerQuery"
+
+namespace
+{
+	/** 没有世界的对象 */
+	const uint32 NoWorldBit = 1u;
+	const uint32 AllWorlds = ~0u;
+
+	uint32 GetWorldBit(EWorldType::Type WorldType)
+	{
+		return 1u << (1 + static_cast<int32>(WorldType));
+	}
+
+	/** 按世界类型名解析 world: 条件，None 同时表示没有世界的对象 */
+	bool ParseWorldType(const FString& Name, uint32& OutBits)
+	{
+		static const TPair<const TCHAR*, EWorldType::Type> WorldTypes[] =
+		{
+			{ TEXT("Editor"), EWorldType::Editor },
+			{ TEXT("PIE"), EWorldType::PIE },
+			{ TEXT("Game"), EWorldType::Game },
+			{ TEXT("EditorPreview"), EWorldType::EditorPreview },
+			{ TEXT("GamePreview"), EWorldType::GamePreview },
+			{ TEXT("GameRPC"), EWorldType::GameRPC },
+			{ TEXT("Inactive"), EWorldType::Inactive },
+		};
+
+		if (Name.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+		{
+			OutBits = NoWorldBit | GetWorldBit(EWorldType::None);
+			return true;
+		}
+		for (const TPair<const TCHAR*, EWorldType::Type>& WorldType : WorldTypes)
+		{
+			if (Name.Equals(WorldType.Key, ESearchCase::IgnoreCase))
+			{
+				OutBits = GetWorldBit(WorldType.Value);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ParseFlag(const FString& Name, EObjRefRowFlags& OutFlag)
+	{
+		static const TPair<const TCHAR*, EObjRefRowFlags> Flags[] =
+		{
+			{ TEXT("GCRoot"), EObjRefRowFlags::GCRoot },
+			{ TEXT("RootSet"), EObjRefRowFlags::RootSet },
+			{ TEXT("Standalone"), EObjRefRowFlags::Standalone },
+			{ TEXT("Transient"), EObjRefRowFlags::Transient },
+		};
+
+		for (const TPair<const TCHAR*, EObjRefRowFlags>& Flag : Flags)
+		{
+			if (Name.Equals(Flag.Key, ESearchCase::IgnoreCase))
+			{
+				OutFlag = Flag.Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsCompareChar(TCHAR Char)
+	{
+		return Char == TEXT('<') || Char == TEXT('>') || Char == TEXT('=') || Char == TEXT('!');
+	}
+
+	/** 解析比较运算符，返回运算符的字符数 */
+	int32 ParseCompare(const FString& Value, EObjRefQueryCompare& OutCompare)
+	{
+		static const TPair<const TCHAR*, EObjRefQueryCompare> Operators[] =
+		{
+			{ TEXT(">="), EObjRefQueryCompare::GreaterEqual },
+			{ TEXT("<="), EObjRefQueryCompare::LessEqual },
+			{ TEXT("!="), EObjRefQueryCompare::NotEqual },
+			{ TEXT(">"), EObjRefQueryCompare::Greater },
+			{ TEXT("<"), EObjRefQueryCompare::Less },
+			{ TEXT("="), EObjRefQueryCompare::Equal },
+		};
+
+		for (const TPair<const TCHAR*, EObjRefQueryCompare>& Operator : Operators)
+		{
+			if (Value.StartsWith(Operator.Key))
+			{
+				OutCompare = Operator.Value;
+				return FCString::Strlen(Operator.Key);
+			}
+		}
+		OutCompare = EObjRefQueryCompare::Equal;
+		return 0;
+	}
+
+	/** 解析数值，可带 B / KB / MB / GB 单位（按 1024 换算） */
+	bool ParseNumber(const FString& Value, int64& OutNumber)
+	{
+		int32 NumberEnd = 0;
+		while (NumberEnd < Value.Len() && (FChar::IsDigit(Value[NumberEnd]) || Value[NumberEnd] == TEXT('.')))
+		{
+			++NumberEnd;
+		}
+		if (NumberEnd == 0)
+		{
+			return false;
+		}
+
+		const FString Unit = Value.Mid(NumberEnd);
+		double Multiplier = 1.0;
+		if (Unit.IsEmpty() || Unit.Equals(TEXT("B"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1.0;
+		}
+		else if (Unit.Equals(TEXT("K"), ESearchCase::IgnoreCase) || Unit.Equals(TEXT("KB"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1024.0;
+		}
+		else if (Unit.Equals(TEXT("M"), ESearchCase::IgnoreCase) || Unit.Equals(TEXT("MB"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1024.0 * 1024.0;
+		}
+		else if (Unit.Equals(TEXT("G"), ESearchCase::IgnoreCase) || Unit.Equals(TEXT("GB"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1024.0 * 1024.0 * 1024.0;
+		}
+		else
+		{
+			return false;
+		}
+
+		OutNumber = static_cast<int64>(FCString::Atod(*Value.Left(NumberEnd)) * Multiplier);
+		return true;
+	}
+
+	bool CompareNumber(int64 Left, EObjRefQueryCompare Compare, int64 Right)
+	{
+		switch (Compare)
+		{
+		case EObjRefQueryCompare::Equal:        return Left == Right;
+		case EObjRefQueryCompare::NotEqual:     return Left != Right;
+		case EObjRefQueryCompare::Less:         return Left < Right;
+		case EObjRefQueryCompare::LessEqual:    return Left <= Right;
+		case EObjRefQueryCompare::Greater:      return Left > Right;
+		case EObjRefQueryCompare::GreaterEqual: return Left >= Right;
+		}
+		return false;
+	}
+
+	/** 按空白拆分查询文本，双引号内的空白保留 */
+	void SplitTerms(const FString& Text, TArray<FString>& OutTerms)
+	{
+		FString Current;
+		bool bInQuotes = false;
+		for (TCHAR Char : Text)
+		{
+			if (Char == TEXT('"'))
+			{
+				bInQuotes = !bInQuotes;
+				continue;
+			}
+			if (!bInQuotes && FChar::IsWhitespace(Char))
+			{
+				if (!Current.IsEmpty())
+				{
+					OutTerms.Add(Current);
+					Current.Reset();
+				}
+				continue;
+			}
+			Current.AppendChar(Char);
+		}
+		if (!Current.IsEmpty())
+		{
+			OutTerms.Add(Current);
+		}
+	}
+
+	/** 对象阶段谓词的求值代价：标志位最便宜，其次是名称比较，需要生成路径字符串的通配符匹配最贵 */
+	int32 GetPredicateCost(const FObjRefQueryPredicate& Predicate)
+	{
+		switch (Predicate.Field)
+		{
+		case EObjRefQueryField::Flags:   return 0;
+		case EObjRefQueryField::Name:    return Predicate.bHasWildcard ? 3 : 1;
+		case EObjRefQueryField::Package: return Predicate.bHasWildcard ? 4 : 1;
+		case EObjRefQueryField::Outer:   return Predicate.bHasWildcard ? 5 : 2;
+		case EObjRefQueryField::Within:  return Predicate.bHasWildcard ? 6 : 2;
+		default:                         return 6;
+		}
+	}
+
+	/** 代价不超过该值的谓词在世界检查（按 Outer 查表，Outer 第一次出现时沿 Outer 链解析）之前求值 */
+	const int32 MaxCheapPredicateCost = 2;
+
+	/**
+	 * 精确路径中最后一段的名称，即路径所指对象的 FName，用于在生成完整路径前快速排除
+	 * 只有 '.' 与 ':' 分隔子对象；不含它们的路径指向一个包，包的 FName 就是完整的包名（如 /Game/Maps/Arena）
+	 */
+	FName GetPathLeafName(const FString& Path)
+	{
+		for (int32 Index = Path.Len() - 1; Index >= 0; --Index)
+		{
+			if (Path[Index] == TEXT('.') || Path[Index] == TEXT(':'))
+			{
+				return FName(*Path.Mid(Index + 1), FNAME_Find);
+			}
+		}
+		return FName(*Path, FNAME_Find);
+	}
+}
+
+FObjRefQuery::FObjRefQuery()
+	: bIsEmpty(true)
+	, NumCheapObjectPredicates(0)
+	, WorldMask(AllWorlds)
+	, IncludedWorlds(0)
+	, ExcludedWorlds(0)
+	, bHasWorldTerm(false)
+	, Source(EObjRefQuerySource::ClassHash)
+{
+}
+
+bool FObjRefQuery::Compile(const FString& Text, const FSearchFilterOptions& Defaults, FObjRefQuery& OutQuery, FString& OutError)
+{
+	OutQuery = FObjRefQuery();
+	OutQuery.Text = Text.TrimStartAndEnd();
+
+	TArray<FString> Terms;
+	SplitTerms(OutQuery.Text, Terms);
+	for (const FString& Term : Terms)
+	{
+		if (!OutQuery.ParseTerm(Term, OutError))
+		{
+			OutError = FString::Printf(TEXT("%s: %s"), *Term, *OutError);
+			return false;
+		}
+	}
+
+	OutQuery.bIsEmpty = Terms.Num() == 0;
+	OutQuery.Finalize(Defaults);
+	return true;
+}
+
+bool FObjRefQuery::ParseTerm(const FString& Term, FString& OutError)
+{
+	int32 KeyEnd = 0;
+	while (KeyEnd < Term.Len() && FChar::IsAlpha(Term[KeyEnd]))
+	{
+		++KeyEnd;
+	}
+
+	// 不带字段名的词按名称子串匹配
+	if (KeyEnd == 0 || KeyEnd == Term.Len() || (Term[KeyEnd] != TEXT(':') && !IsCompareChar(Term[KeyEnd])))
+	{
+		FObjRefQueryPredicate Predicate;
+		Predicate.Field = EObjRefQueryField::Name;
+		Predicate.Pattern = FString::Printf(TEXT("*%s*"), *Term);
+		Predicate.bHasWildcard = true;
+		ObjectPredicates.Add(Predicate);
+		return true;
+	}
+
+	const FString Key = Term.Left(KeyEnd).ToLower();
+	FString Value = Term.Mid(KeyEnd);
+
+	// 数值字段：refs>3、size>=1MB、retained:0（冒号等同于等号）
+	if (Key == TEXT("refs") || Key == TEXT("size") || Key == TEXT("retained"))
+	{
+		if (Value.StartsWith(TEXT(":")))
+		{
+			Value = Value.RightChop(1);
+		}
+
+		FObjRefQueryPredicate Predicate;
+		Predicate.Field = Key == TEXT("refs") ? EObjRefQueryField::References : (Key == TEXT("size") ? EObjRefQueryField::Size : EObjRefQueryField::Retained);
+		Value = Value.RightChop(ParseCompare(Value, Predicate.Compare));
+		if (!ParseNumber(Value, Predicate.Number))
+		{
+			OutError = TEXT("无法解析数值");
+			return false;
+		}
+		RowPredicates.Add(Predicate);
+		return true;
+	}
+
+	if (!Value.StartsWith(TEXT(":")))
+	{
+		OutError = FString::Printf(TEXT("字段 %s 需要使用 ':'"), *Key);
+		return false;
+	}
+	Value = Value.RightChop(1);
+
+	// class、world 与 flags 可用逗号列出多个值，每个值都可以用 ! 取反
+	if (Key == TEXT("class") || Key == TEXT("world") || Key == TEXT("flags"))
+	{
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT(","));
+		if (Items.Num() == 0)
+		{
+			OutError = TEXT("缺少取值");
+			return false;
+		}
+
+		for (FString Item : Items)
+		{
+			const bool bNegated = Item.StartsWith(TEXT("!"));
+			if (bNegated)
+			{
+				Item = Item.RightChop(1);
+			}
+
+			if (Key == TEXT("class"))
+			{
+				(bNegated ? ExcludedClassNames : ClassNames).AddUnique(Item);
+			}
+			else if (Key == TEXT("world"))
+			{
+				uint32 WorldBits = 0;
+				if (!ParseWorldType(Item, WorldBits))
+				{
+					OutError = FString::Printf(TEXT("未知的世界类型 %s（可用 Editor、PIE、Game、EditorPreview、GamePreview、Inactive、None）"), *Item);
+					return false;
+				}
+				(bNegated ? ExcludedWorlds : IncludedWorlds) |= WorldBits;
+				bHasWorldTerm = true;
+			}
+			else
+			{
+				FObjRefQueryPredicate Predicate;
+				Predicate.Field = EObjRefQueryField::Flags;
+				Predicate.bNegated = bNegated;
+				if (!ParseFlag(Item, Predicate.Flag))
+				{
+					OutError = FString::Printf(TEXT("未知的标志 %s（可用 GCRoot、RootSet、Standalone、Transient）"), *Item);
+					return false;
+				}
+
+				// GC根标志来自引用图，只能在结果表上求值
+				(Predicate.Flag == EObjRefRowFlags::GCRoot ? RowPredicates : ObjectPredicates).Add(Predicate);
+			}
+		}
+		return true;
+	}
+
+	EObjRefQueryField Field;
+	if (Key == TEXT("name"))
+	{
+		Field = EObjRefQueryField::Name;
+	}
+	else if (Key == TEXT("outer"))
+	{
+		Field = EObjRefQueryField::Outer;
+	}
+	else if (Key == TEXT("within"))
+	{
+		Field = EObjRefQueryField::Within;
+	}
+	else if (Key == TEXT("package"))
+	{
+		Field = EObjRefQueryField::Package;
+	}
+	else
+	{
+		OutError = FString::Printf(TEXT("未知的字段 %s"), *Key);
+		return false;
+	}
+
+	const bool bNegated = Value.StartsWith(TEXT("!"));
+	if (bNegated)
+	{
+		Value = Value.RightChop(1);
+	}
+	if (Value.IsEmpty())
+	{
+		OutError = TEXT("缺少取值");
+		return false;
+	}
+
+	AddPathPredicate(Field, Value, bNegated);
+	return true;
+}
+
+void FObjRefQuery::AddPathPredicate(EObjRefQueryField Field, const FString& Pattern, bool bNegated)
+{
+	FObjRefQueryPredicate Predicate;
+	Predicate.Field = Field;
+	Predicate.bNegated = bNegated;
+	Predicate.Pattern = Pattern;
+	Predicate.bHasWildcard = Pattern.Contains(TEXT("*")) || Pattern.Contains(TEXT("?"));
+	if (!Predicate.bHasWildcard)
+	{
+		// 名称表中不存在的名称不可能属于任何对象，ExactName 保持 None
+		const bool bIsPath = Field == EObjRefQueryField::Outer || Field == EObjRefQueryField::Within;
+		Predicate.ExactName = bIsPath ? GetPathLeafName(Pattern) : FName(*Pattern, FNAME_Find);
+	}
+	ObjectPredicates.Add(Predicate);
+}
+
+void FObjRefQuery::Finalize(const FSearchFilterOptions& Defaults)
+{
+	// 搜索范围选择器等同于一个精确路径条件，与查询中的条件一起参与候选来源的选择
+	const FString ScopePath = Defaults.ScopePath.TrimStartAndEnd();
+	if (Defaults.ScopeMode != EObjRefScopeMode::Global && !ScopePath.IsEmpty())
+	{
+		switch (Defaults.ScopeMode)
+		{
+		case EObjRefScopeMode::Outer:     AddPathPredicate(EObjRefQueryField::Outer, ScopePath, false); break;
+		case EObjRefScopeMode::OuterTree: AddPathPredicate(EObjRefQueryField::Within, ScopePath, false); break;
+		case EObjRefScopeMode::Package:   AddPathPredicate(EObjRefQueryField::Package, ScopePath, false); break;
+		default: break;
+		}
+		bIsEmpty = false;
+	}
+
+	if (bHasWorldTerm)
+	{
+		WorldMask = (IncludedWorlds != 0 ? IncludedWorlds : AllWorlds) & ~ExcludedWorlds;
+	}
+	else
+	{
+		WorldMask = AllWorlds;
+		if (!Defaults.bIncludeEditorWorld)
+		{
+			WorldMask &= ~GetWorldBit(EWorldType::Editor);
+		}
+		if (!Defaults.bIncludePIEWorld)
+		{
+			WorldMask &= ~GetWorldBit(EWorldType::PIE);
+		}
+		if (!Defaults.bIncludeGameWorld)
+		{
+			WorldMask &= ~GetWorldBit(EWorldType::Game);
+		}
+	}
+
+	// 便宜的谓词先求值，多数候选在生成任何字符串之前就被排除
+	Algo::StableSortBy(ObjectPredicates, &GetPredicateCost);
+	NumCheapObjectPredicates = 0;
+	while (NumCheapObjectPredicates < ObjectPredicates.Num() && GetPredicateCost(ObjectPredicates[NumCheapObjectPredicates]) <= MaxCheapPredicateCost)
+	{
+		++NumCheapObjectPredicates;
+	}
+
+	// 精确的 Outer 只有直接子对象，比它的整棵 Outer 树更窄，Outer 树又通常比整个包更窄；
+	// 三者都比类哈希中的同类对象少得多
+	static const TPair<EObjRefQueryField, EObjRefQuerySource> SourceFields[] =
+	{
+		{ EObjRefQueryField::Outer, EObjRefQuerySource::Outer },
+		{ EObjRefQueryField::Within, EObjRefQuerySource::OuterTree },
+		{ EObjRefQueryField::Package, EObjRefQuerySource::Package },
+	};
+
+	Source = EObjRefQuerySource::ClassHash;
+	SourcePath.Reset();
+	for (const TPair<EObjRefQueryField, EObjRefQuerySource>& SourceField : SourceFields)
+	{
+		for (const FObjRefQueryPredicate& Predicate : ObjectPredicates)
+		{
+			if (Predicate.Field == SourceField.Key && !Predicate.bNegated && !Predicate.bHasWildcard)
+			{
+				Source = SourceField.Value;
+				SourcePath = Predicate.Pattern;
+				return;
+			}
+		}
+	}
+}
+
+void FObjRefQuery::BindSourceObject(UObject* SourceObject)
+{
+	if (Source == EObjRefQuerySource::ClassHash || !SourceObject)
+	{
+		return;
+	}
+
+	const EObjRefQueryField SourceField =
+		Source == EObjRefQuerySource::Outer ? EObjRefQueryField::Outer :
+		(Source == EObjRefQuerySource::OuterTree ? EObjRefQueryField::Within : EObjRefQueryField::Package);
+
+	for (FObjRefQueryPredicate& Predicate : ObjectPredicates)
+	{
+		if (Predicate.Field == SourceField && !Predicate.bNegated && !Predicate.bHasWildcard
+			&& Predicate.Pattern.Equals(SourcePath, ESearchCase::IgnoreCase))
+		{
+			Predicate.ScopeObject = SourceObject;
+			Predicate.bHasScopeObject = true;
+		}
+	}
+}
+
+bool FObjRefQuery::MatchesObject(UObject* Object, FObjRefWorldCache& WorldCache) const
+{
+	// 过滤无效与待销毁的对象、类默认对象 (CDO) 和原型对象
+	if (!IsValid(Object) || Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < NumCheapObjectPredicates; ++Index)
+	{
+		if (!MatchesObjectPredicate(ObjectPredicates[Index], Object))
+		{
+			return false;
+		}
+	}
+
+	if (WorldMask != AllWorlds)
+	{
+		UWorld* ObjectWorld = WorldCache.GetWorld(Object);
+		if (!(WorldMask & (ObjectWorld ? GetWorldBit(ObjectWorld->WorldType) : NoWorldBit)))
+		{
+			return false;
+		}
+	}
+
+	for (int32 Index = NumCheapObjectPredicates; Index < ObjectPredicates.Num(); ++Index)
+	{
+		if (!MatchesObjectPredicate(ObjectPredicates[Index], Object))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FObjRefQuery::MatchesObjectPredicate(const FObjRefQueryPredicate& Predicate, UObject* Object)
+{
+	bool bMatches = false;
+
+	// 候选来源对象已解析时按身份比较；来源对象已被回收时范围内不再有任何对象
+	if (Predicate.bHasScopeObject)
+	{
+		if (const UObject* Scope = Predicate.ScopeObject.Get())
+		{
+			switch (Predicate.Field)
+			{
+			case EObjRefQueryField::Outer:   bMatches = Object->GetOuter() == Scope; break;
+			case EObjRefQueryField::Within:  bMatches = Object->IsIn(Scope); break;
+			case EObjRefQueryField::Package: bMatches = Object->GetOutermost() == Scope; break;
+			default: break;
+			}
+		}
+		return bMatches != Predicate.bNegated;
+	}
+
+	switch (Predicate.Field)
+	{
+	case EObjRefQueryField::Flags:
+		bMatches = EnumHasAnyFlags(FObjRefInstanceTable::GetObjectFlags(Object), Predicate.Flag);
+		break;
+
+	case EObjRefQueryField::Name:
+		bMatches = Predicate.bHasWildcard ?
+			Object->GetName().MatchesWildcard(Predicate.Pattern) :
+			!Predicate.ExactName.IsNone() && Object->GetFName() == Predicate.ExactName;
+		break;
+
+	case EObjRefQueryField::Package:
+		bMatches = Predicate.bHasWildcard ?
+			Object->GetOutermost()->GetName().MatchesWildcard(Predicate.Pattern) :
+			!Predicate.ExactName.IsNone() && Object->GetOutermost()->GetFName() == Predicate.ExactName;
+		break;
+
+	case EObjRefQueryField::Outer:
+		if (const UObject* Outer = Object->GetOuter())
+		{
+			// 精确路径先比较最后一段名称，名称相同时才生成完整路径
+			bMatches = Predicate.bHasWildcard ?
+				Outer->GetPathName().MatchesWildcard(Predicate.Pattern) :
+				!Predicate.ExactName.IsNone() && Outer->GetFName() == Predicate.ExactName && Outer->GetPathName().Equals(Predicate.Pattern, ESearchCase::IgnoreCase);
+		}
+		break;
+
+	case EObjRefQueryField::Within:
+		// 沿 Outer 链逐层比较，精确路径同样先比较名称
+		for (const UObject* Outer = Object->GetOuter(); Outer && !bMatches; Outer = Outer->GetOuter())
+		{
+			bMatches = Predicate.bHasWildcard ?
+				Outer->GetPathName().MatchesWildcard(Predicate.Pattern) :
+				!Predicate.ExactName.IsNone() && Outer->GetFName() == Predicate.ExactName && Outer->GetPathName().Equals(Predicate.Pattern, ESearchCase::IgnoreCase);
+		}
+		break;
+
+	default:
+		break;
+	}
+	return bMatches != Predicate.bNegated;
+}
+
+bool FObjRefQuery::MatchesRow(const FObjRefInstanceTable& Table, int32 Row) const
+{
+	for (const FObjRefQueryPredicate& Predicate : RowPredicates)
+	{
+		if (!MatchesRowPredicate(Predicate, Table, Row))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FObjRefQuery::MatchesRowPredicate(const FObjRefQueryPredicate& Predicate, const FObjRefInstanceTable& Table, int32 Row)
+{
+	bool bMatches = false;
+	switch (Predicate.Field)
+	{
+	case EObjRefQueryField::Flags:
+		bMatches = EnumHasAnyFlags(Table.GetFlags()[Row], Predicate.Flag);
+		break;
+
+	case EObjRefQueryField::References:
+		bMatches = CompareNumber(Table.GetReferenceCounts()[Row], Predicate.Compare, Predicate.Number);
+		break;
+
+	case EObjRefQueryField::Size:
+		bMatches = CompareNumber(Table.GetMemorySizes()[Row], Predicate.Compare, Predicate.Number);
+		break;
+
+	case EObjRefQueryField::Retained:
+		bMatches = CompareNumber(Table.GetRetainedSizes()[Row], Predicate.Compare, Predicate.Number);
+		break;
+
+	default:
+		break;
+	}
+	return bMatches != Predicate.bNegated;
+}
+
+bool FObjRefQuery::AcceptsWorldType(EWorldType::Type WorldType) const
+{
+	return (WorldMask & GetWorldBit(WorldType)) != 0;
+}
+
+bool FObjRefQuery::UsesField(EObjRefQueryField Field) const
+{
+	const auto HasField = [Field](const FObjRefQueryPredicate& Predicate) { return Predicate.Field == Field; };
+	return ObjectPredicates.ContainsByPredicate(HasField) || RowPredicates.ContainsByPredicate(HasField);
+}
+
+bool FObjRefQuery::NeedsReferenceGraph() const
+{
+	return RowPredicates.ContainsByPredicate([](const FObjRefQueryPredicate& Predicate)
+	{
+		return Predicate.Field == EObjRefQueryField::References || Predicate.Field == EObjRefQueryField::Flags;
+	});
+}
+
+FText FObjRefQuery::GetSyntaxHelp()
+{
+	return LOCTEXT("QuerySyntaxHelp",
+		"空格分隔的条件同时满足才算匹配，值前加 ! 表示取反：\n"
+		"  class:类名[,类名]   目标类（含子类），!类名 排除该类及其子类\n"
+		"  name:名称           对象名称，支持 * 与 ? 通配符\n"
+		"  outer:路径          直接 Outer 的路径；精确路径时只枚举该 Outer 的子对象\n"
+		"  within:路径         任意一层 Outer 的路径；精确路径时只枚举该 Outer 下的所有嵌套对象\n"
+		"  package:包名        所在包；精确包名时只枚举包内对象\n"
+		"  world:类型          Editor / PIE / Game / EditorPreview / GamePreview / Inactive / None\n"
+		"  flags:标志          GCRoot / RootSet / Standalone / Transient\n"
+		"  refs>3  size>1MB  retained>=512KB   比较运算 = != < <= > >=\n"
+		"不带字段名的词按名称子串匹配。");
+}
+
+#undef LOCTEXT_NAMESPACE
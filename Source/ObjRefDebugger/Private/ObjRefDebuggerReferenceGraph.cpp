@@ -0,0 +1,695 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/GarbageCollection.h"
+#include "Async/ParallelFor.h"
+
+const FName FObjRefReferenceGraph::OuterPropertyName(TEXT("<Outer>"));
+const FName FObjRefReferenceGraph::ClassPropertyName(TEXT("<Class>"));
+
+/** 正向引用边：当前对象通过 PropertyName 强引用了 TargetIndex 对应的对象 */
+struct FObjRefOutgoingEdge
+{
+	int32 TargetIndex;
+	FName PropertyName;
+
+	FObjRefOutgoingEdge(int32 InTargetIndex, FName InPropertyName)
+		: TargetIndex(InTargetIndex)
+		, PropertyName(InPropertyName)
+	{
+	}
+};
+
+/** 引用收集器：记录单个对象的所有出边 */
+class FObjRefEdgeCollector : public FReferenceFinder
+{
+public:
+	FObjRefEdgeCollector(TArray<UObject*>& InScratchArray, TArray<FObjRefOutgoingEdge>& InOutEdges)
+		: FReferenceFinder(InScratchArray)
+		, OutEdges(InOutEdges)
+	{
+	}
+
+	virtual void HandleObjectReference(UObject*& InObject, const UObject* InReferencingObject, const FProperty* InReferencingProperty) override
+	{
+		if (InObject)
+		{
+			OutEdges.Emplace(GUObjectArray.ObjectToIndex(InObject), InReferencingProperty ? InReferencingProperty->GetFName() : NAME_None);
+		}
+	}
+
+	/** 收集对象的全部强引用，与GC标记阶段一致：UPROPERTY、AddReferencedObjects、Outer 和 Class */
+	void CollectFrom(UObject* Object)
+	{
+		FindReferences(Object);
+
+		if (UObject* Outer = Object->GetOuter())
+		{
+			OutEdges.Emplace(GUObjectArray.ObjectToIndex(Outer), FObjRefReferenceGraph::OuterPropertyName);
+		}
+		if (UClass* Class = Object->GetClass())
+		{
+			OutEdges.Emplace(GUObjectArray.ObjectToIndex(Class), FObjRefReferenceGraph::ClassPropertyName);
+		}
+	}
+
+private:
+	TArray<FObjRefOutgoingEdge>& OutEdges;
+};
+
+/** 分块收集阶段使用的完整边，PropertyId 是分块内的局部属性下标 */
+struct FObjRefChunkEdge
+{
+	int32 SourceIndex;
+	int32 TargetIndex;
+	int32 PropertyId;
+
+	FObjRefChunkEdge(int32 InSourceIndex, int32 InTargetIndex, int32 InPropertyId)
+		: SourceIndex(InSourceIndex)
+		, TargetIndex(InTargetIndex)
+		, PropertyId(InPropertyId)
+	{
+	}
+};
+
+/** 单个分块的收集结果：按源对象索引有序的边 + 分块内的属性名表 */
+struct FObjRefChunkResult
+{
+	TArray<FObjRefChunkEdge> Edges;
+	TArray<FName> PropertyNames;
+	TMap<FName, int32> PropertyIds;
+
+	int32 InternProperty(FName PropertyName)
+	{
+		if (const int32* ExistingId = PropertyIds.Find(PropertyName))
+		{
+			return *ExistingId;
+		}
+		const int32 NewId = PropertyNames.Add(PropertyName);
+		PropertyIds.Add(PropertyName, NewId);
+		return NewId;
+	}
+};
+
+/** 与 GC 标记阶段的根判定保持一致 */
+static EObjRefRootKind ClassifyRoot(const FUObjectItem* ObjectItem, const UObject* Object)
+{
+	if (ObjectItem->IsRootSet())
+	{
+		return EObjRefRootKind::RootSet;
+	}
+	if (GUObjectArray.IsDisregardForGC(Object))
+	{
+		return EObjRefRootKind::DisregardForGC;
+	}
+	if (Object->HasAnyFlags(GARBAGE_COLLECTION_KEEPFLAGS))
+	{
+		return EObjRefRootKind::KeepFlags;
+	}
+	return EObjRefRootKind::None;
+}
+
+/** 收集 [BeginIndex, EndIndex) 范围内所有对象的出边和根类型，可在工作线程上调用 */
+static void CollectChunk(int32 BeginIndex, int32 EndIndex, int32 NumObjects, FObjRefChunkResult& OutResult, uint8* OutRootKinds)
+{
+	TArray<UObject*> ScratchArray;
+	TArray<FObjRefOutgoingEdge> OutgoingEdges;
+	FObjRefEdgeCollector Collector(ScratchArray, OutgoingEdges);
+
+	for (int32 ObjectIndex = BeginIndex; ObjectIndex < EndIndex; ++ObjectIndex)
+	{
+		UObject* Object = FObjRefReferenceGraph::GetObjectByIndex(ObjectIndex);
+
+		// 跳过尚未构造完成或正在异步加载的对象，它们的引用还不完整
+		if (!Object || Object->HasAnyFlags(RF_NeedInitialization) || Object->HasAnyInternalFlags(EInternalObjectFlags::AsyncLoading))
+		{
+			continue;
+		}
+
+		OutRootKinds[ObjectIndex] = static_cast<uint8>(ClassifyRoot(GUObjectArray.IndexToObject(ObjectIndex), Object));
+
+		OutgoingEdges.Reset();
+		Collector.CollectFrom(Object);
+
+		for (const FObjRefOutgoingEdge& Edge : OutgoingEdges)
+		{
+			// 只保留快照范围内的目标，忽略自引用
+			if (Edge.TargetIndex != ObjectIndex && Edge.TargetIndex >= 0 && Edge.TargetIndex < NumObjects)
+			{
+				OutResult.Edges.Emplace(ObjectIndex, Edge.TargetIndex, OutResult.InternProperty(Edge.PropertyName));
+			}
+		}
+	}
+}
+
+FObjRefReferenceGraph::FObjRefReferenceGraph()
+	: NumOverlayEdges(0)
+	, CurrentVisitStamp(0)
+	, GCEpoch(0)
+	, Version(0)
+	, bHasSnapshot(false)
+	, bListenersRegistered(false)
+	, BuildMode(EObjRefGraphBuildMode::Parallel)
+{
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FObjRefReferenceGraph::OnPostGarbageCollect);
+
+	GUObjectArray.AddUObjectCreateListener(this);
+	GUObjectArray.AddUObjectDeleteListener(this);
+	bListenersRegistered = true;
+}
+
+FObjRefReferenceGraph::~FObjRefReferenceGraph()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	UnregisterListeners();
+}
+
+void FObjRefReferenceGraph::UnregisterListeners()
+{
+	if (bListenersRegistered)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bListenersRegistered = false;
+	}
+}
+
+void FObjRefReferenceGraph::EnsureUpToDate()
+{
+	// 等待工作线程上的查询结束后再修改引用图
+	FRWScopeLock WriteLock(GraphLock, SLT_Write);
+
+	if (!bHasSnapshot)
+	{
+		Rebuild(BuildMode);
+	}
+	else
+	{
+		ApplyPendingChanges();
+	}
+}
+
+void FObjRefReferenceGraph::Rebuild(EObjRefGraphBuildMode Mode)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 构建期间阻止GC，保证对象索引稳定；在游戏线程上调用时不会阻塞自身
+	FGCScopeGuard GCGuard;
+
+	// 完整快照会覆盖之前的所有增量记录；构建期间新产生的通知保留到下一次增量更新，
+	// 所以在清空记录的同时开始接收通知
+	{
+		FScopeLock Lock(&PendingLock);
+		PendingDirtyObjects.Reset();
+		PendingDeletedObjects.Reset();
+		bHasSnapshot = true;
+	}
+	OverlayOutEdges.Reset();
+	OverlayInEdges.Reset();
+	NumOverlayEdges = 0;
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumObjects, ObjectsPerChunk);
+
+	OverriddenSources.Init(false, NumObjects);
+
+	// 每个分块独立收集出边，避免线程间共享缓冲
+	TArray<FObjRefChunkResult> ChunkResults;
+	ChunkResults.SetNum(NumChunks);
+
+	// 各分块只写入自己范围内的槽位，可以安全地共享同一个数组
+	RootKinds.Reset();
+	RootKinds.SetNumZeroed(NumObjects);
+	uint8* RootKindData = RootKinds.GetData();
+
+	ParallelFor(NumChunks, [&ChunkResults, NumObjects, RootKindData](int32 ChunkIndex)
+	{
+		CollectChunk(ChunkIndex * ObjectsPerChunk, FMath::Min((ChunkIndex + 1) * ObjectsPerChunk, NumObjects), NumObjects, ChunkResults[ChunkIndex], RootKindData);
+	}, Mode == EObjRefGraphBuildMode::SingleThreaded);
+
+	const double CollectTime = FPlatformTime::Seconds();
+
+	// 合并分块属性名表，得到局部下标到全局下标的映射
+	PropertyNames.Reset();
+	PropertyIdsByName.Reset();
+	TArray<TArray<int32>> PropertyRemaps;
+	PropertyRemaps.SetNum(NumChunks);
+
+	int32 TotalEdges = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		const FObjRefChunkResult& Chunk = ChunkResults[ChunkIndex];
+		TArray<int32>& Remap = PropertyRemaps[ChunkIndex];
+		Remap.SetNumUninitialized(Chunk.PropertyNames.Num());
+		for (int32 LocalId = 0; LocalId < Chunk.PropertyNames.Num(); ++LocalId)
+		{
+			const FName PropertyName = Chunk.PropertyNames[LocalId];
+			Remap[LocalId] = InternPropertyName(PropertyName);
+		}
+		TotalEdges += Chunk.Edges.Num();
+	}
+
+	// 统计出度与入度，前缀和得到两组 CSR 偏移
+	OutOffsets.Reset();
+	OutOffsets.SetNumZeroed(NumObjects + 1);
+	InOffsets.Reset();
+	InOffsets.SetNumZeroed(NumObjects + 1);
+	for (const FObjRefChunkResult& Chunk : ChunkResults)
+	{
+		for (const FObjRefChunkEdge& Edge : Chunk.Edges)
+		{
+			++OutOffsets[Edge.SourceIndex + 1];
+			++InOffsets[Edge.TargetIndex + 1];
+		}
+	}
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		OutOffsets[ObjectIndex + 1] += OutOffsets[ObjectIndex];
+		InOffsets[ObjectIndex + 1] += InOffsets[ObjectIndex];
+	}
+
+	// 分块内的边已按源索引有序，正向邻接直接顺序写入；反向邻接按目标做一次计数排序
+	OutTargets.Reset();
+	OutTargets.SetNumUninitialized(TotalEdges);
+	InSources.Reset();
+	InSources.SetNumUninitialized(TotalEdges);
+	InPropertyIds.Reset();
+	InPropertyIds.SetNumUninitialized(TotalEdges);
+
+	TArray<int32> InCursors(InOffsets.GetData(), NumObjects);
+	int32 OutCursor = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		FObjRefChunkResult& Chunk = ChunkResults[ChunkIndex];
+		const TArray<int32>& Remap = PropertyRemaps[ChunkIndex];
+		for (const FObjRefChunkEdge& Edge : Chunk.Edges)
+		{
+			OutTargets[OutCursor++] = Edge.TargetIndex;
+
+			const int32 InSlot = InCursors[Edge.TargetIndex]++;
+			InSources[InSlot] = Edge.SourceIndex;
+			InPropertyIds[InSlot] = Remap[Edge.PropertyId];
+		}
+		Chunk.Edges.Empty();
+	}
+
+	++Version;
+
+	const double EndTime = FPlatformTime::Seconds();
+	UE_LOG(LogTemp, Log, TEXT("引用图构建完成(%s): %d 个对象槽位, %d 条边, %d 个属性名, %.1f MB, 收集 %.3f 秒, 合并 %.3f 秒"),
+		Mode == EObjRefGraphBuildMode::Parallel ? TEXT("并行") : TEXT("单线程"),
+		NumObjects, TotalEdges, PropertyNames.Num(), GetAllocatedSize() / (1024.0f * 1024.0f),
+		CollectTime - StartTime, EndTime - CollectTime);
+}
+
+void FObjRefReferenceGraph::Invalidate()
+{
+	bHasSnapshot = false;
+}
+
+bool FObjRefReferenceGraph::IsUpToDate() const
+{
+	FScopeLock Lock(&PendingLock);
+	return bHasSnapshot && PendingDirtyObjects.Num() == 0 && PendingDeletedObjects.Num() == 0;
+}
+
+void FObjRefReferenceGraph::ApplyPendingChanges()
+{
+	TSet<int32> DirtyObjects;
+	TSet<int32> DeletedObjects;
+	{
+		FScopeLock Lock(&PendingLock);
+		Swap(DirtyObjects, PendingDirtyObjects);
+		Swap(DeletedObjects, PendingDeletedObjects);
+	}
+
+	if (DirtyObjects.Num() == 0 && DeletedObjects.Num() == 0)
+	{
+		return;
+	}
+
+	// 脏对象过多时增量更新不再划算，直接完整重建
+	const int32 NumBaseObjects = InOffsets.Num() > 0 ? InOffsets.Num() - 1 : 0;
+	if (DirtyObjects.Num() + DeletedObjects.Num() > FMath::Max(NumBaseObjects / MaxDirtyFractionDivisor, MinFullRebuildThreshold))
+	{
+		UE_LOG(LogTemp, Log, TEXT("引用图脏对象过多 (%d)，执行完整重建"), DirtyObjects.Num() + DeletedObjects.Num());
+		Rebuild(BuildMode);
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// GC 会把存活对象中指向已销毁对象的引用清空，这些引用者的出边也发生了变化
+	for (int32 DeletedIndex : DeletedObjects)
+	{
+		ForEachReferencer(DeletedIndex, [&DirtyObjects](int32 SourceIndex, int32 PropertyId)
+		{
+			DirtyObjects.Add(SourceIndex);
+		});
+		DirtyObjects.Add(DeletedIndex);
+	}
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	if (RootKinds.Num() < NumObjects)
+	{
+		RootKinds.SetNumZeroed(NumObjects);
+	}
+
+	TArray<UObject*> ScratchArray;
+	TArray<FObjRefOutgoingEdge> OutgoingEdges;
+	FObjRefEdgeCollector Collector(ScratchArray, OutgoingEdges);
+
+	int32 NumRescanned = 0;
+	for (int32 ObjectIndex : DirtyObjects)
+	{
+		if (ObjectIndex < 0 || ObjectIndex >= NumObjects)
+		{
+			continue;
+		}
+
+		if (OverriddenSources.IsValidIndex(ObjectIndex))
+		{
+			OverriddenSources[ObjectIndex] = true;
+		}
+
+		UObject* Object = GetObjectByIndex(ObjectIndex);
+		if (!Object)
+		{
+			// 对象已销毁：清空它的出边
+			RootKinds[ObjectIndex] = static_cast<uint8>(EObjRefRootKind::None);
+			ReplaceOverlayEdges(ObjectIndex, TArray<FObjRefOverlayEdge>());
+			continue;
+		}
+
+		if (Object->HasAnyFlags(RF_NeedInitialization) || Object->HasAnyInternalFlags(EInternalObjectFlags::AsyncLoading))
+		{
+			// 仍在构造或加载中，留到下一次再扫描
+			FScopeLock Lock(&PendingLock);
+			PendingDirtyObjects.Add(ObjectIndex);
+			continue;
+		}
+
+		RootKinds[ObjectIndex] = static_cast<uint8>(ClassifyRoot(GUObjectArray.IndexToObject(ObjectIndex), Object));
+
+		OutgoingEdges.Reset();
+		Collector.CollectFrom(Object);
+
+		TArray<FObjRefOverlayEdge> NewEdges;
+		NewEdges.Reserve(OutgoingEdges.Num());
+		for (const FObjRefOutgoingEdge& Edge : OutgoingEdges)
+		{
+			if (Edge.TargetIndex != ObjectIndex && Edge.TargetIndex >= 0 && Edge.TargetIndex < NumObjects)
+			{
+				NewEdges.Emplace(Edge.TargetIndex, InternPropertyName(Edge.PropertyName));
+			}
+		}
+		ReplaceOverlayEdges(ObjectIndex, MoveTemp(NewEdges));
+		++NumRescanned;
+	}
+
+	++Version;
+
+	UE_LOG(LogTemp, Log, TEXT("引用图增量更新: 重新扫描 %d 个对象, 销毁 %d 个, 覆盖层 %d 条边, 用时 %.3f 秒"),
+		NumRescanned, DeletedObjects.Num(), NumOverlayEdges, FPlatformTime::Seconds() - StartTime);
+
+	// 覆盖层过大时合并回 CSR，保证查询依然是顺序访存
+	if (NumOverlayEdges > FMath::Max(GetNumEdges() / MaxDirtyFractionDivisor, MinFullRebuildThreshold))
+	{
+		Rebuild(BuildMode);
+	}
+}
+
+void FObjRefReferenceGraph::ReplaceOverlayEdges(int32 SourceIndex, TArray<FObjRefOverlayEdge>&& NewEdges)
+{
+	// 先撤销该源对象上一次写入覆盖层的反向边
+	if (TArray<FObjRefOverlayEdge>* OldEdges = OverlayOutEdges.Find(SourceIndex))
+	{
+		for (const FObjRefOverlayEdge& OldEdge : *OldEdges)
+		{
+			if (TArray<FObjRefOverlayEdge>* InEdges = OverlayInEdges.Find(OldEdge.ObjectIndex))
+			{
+				InEdges->RemoveSingleSwap(FObjRefOverlayEdge(SourceIndex, OldEdge.PropertyId), false);
+				if (InEdges->Num() == 0)
+				{
+					OverlayInEdges.Remove(OldEdge.ObjectIndex);
+				}
+			}
+		}
+		NumOverlayEdges -= OldEdges->Num();
+	}
+
+	for (const FObjRefOverlayEdge& NewEdge : NewEdges)
+	{
+		OverlayInEdges.FindOrAdd(NewEdge.ObjectIndex).Emplace(SourceIndex, NewEdge.PropertyId);
+	}
+	NumOverlayEdges += NewEdges.Num();
+
+	OverlayOutEdges.Add(SourceIndex, MoveTemp(NewEdges));
+}
+
+int32 FObjRefReferenceGraph::InternPropertyName(FName PropertyName)
+{
+	if (const int32* ExistingId = PropertyIdsByName.Find(PropertyName))
+	{
+		return *ExistingId;
+	}
+	const int32 NewId = PropertyNames.Add(PropertyName);
+	PropertyIdsByName.Add(PropertyName, NewId);
+	return NewId;
+}
+
+void FObjRefReferenceGraph::GetReferencers(const UObject* Target, TArray<FObjRefGraphEdge>& OutEdges) const
+{
+	OutEdges.Reset();
+
+	if (!Target)
+	{
+		return;
+	}
+
+	ForEachReferencer(GUObjectArray.ObjectToIndex(Target), [this, &OutEdges](int32 SourceIndex, int32 PropertyId)
+	{
+		OutEdges.Emplace(SourceIndex, GetPropertyName(PropertyId));
+	});
+}
+
+void FObjRefReferenceGraph::ForEachReferencer(int32 ObjectIndex, TFunctionRef<void(int32 SourceIndex, int32 PropertyId)> Visitor) const
+{
+	const TArrayView<const int32> Sources = GetRange(InOffsets, InSources, ObjectIndex);
+	const TArrayView<const int32> PropertyIds = GetRange(InOffsets, InPropertyIds, ObjectIndex);
+	for (int32 EdgeIndex = 0; EdgeIndex < Sources.Num(); ++EdgeIndex)
+	{
+		// 出边已被覆盖层取代的源对象以覆盖层为准；快照之后被销毁的引用者直接跳过
+		const int32 SourceIndex = Sources[EdgeIndex];
+		if (!IsBaseSourceOverridden(SourceIndex) && GetObjectByIndex(SourceIndex))
+		{
+			Visitor(SourceIndex, PropertyIds[EdgeIndex]);
+		}
+	}
+
+	if (const TArray<FObjRefOverlayEdge>* InEdges = OverlayInEdges.Find(ObjectIndex))
+	{
+		for (const FObjRefOverlayEdge& Edge : *InEdges)
+		{
+			if (GetObjectByIndex(Edge.ObjectIndex))
+			{
+				Visitor(Edge.ObjectIndex, Edge.PropertyId);
+			}
+		}
+	}
+}
+
+void FObjRefReferenceGraph::ForEachReference(int32 ObjectIndex, TFunctionRef<void(int32 TargetIndex)> Visitor) const
+{
+	if (const TArray<FObjRefOverlayEdge>* OutEdges = OverlayOutEdges.Find(ObjectIndex))
+	{
+		for (const FObjRefOverlayEdge& Edge : *OutEdges)
+		{
+			Visitor(Edge.ObjectIndex);
+		}
+		return;
+	}
+
+	if (!IsBaseSourceOverridden(ObjectIndex))
+	{
+		for (int32 TargetIndex : GetRange(OutOffsets, OutTargets, ObjectIndex))
+		{
+			Visitor(TargetIndex);
+		}
+	}
+}
+
+TArrayView<const int32> FObjRefReferenceGraph::GetRange(const TArray<int32>& Offsets, const TArray<int32>& Values, int32 ObjectIndex)
+{
+	if (ObjectIndex < 0 || ObjectIndex + 1 >= Offsets.Num())
+	{
+		return TArrayView<const int32>();
+	}
+
+	const int32 Begin = Offsets[ObjectIndex];
+	return TArrayView<const int32>(Values.GetData() + Begin, Offsets[ObjectIndex + 1] - Begin);
+}
+
+SIZE_T FObjRefReferenceGraph::GetAllocatedSize() const
+{
+	return InOffsets.GetAllocatedSize() + InSources.GetAllocatedSize() + InPropertyIds.GetAllocatedSize()
+		+ OutOffsets.GetAllocatedSize() + OutTargets.GetAllocatedSize() + PropertyNames.GetAllocatedSize()
+		+ PropertyIdsByName.GetAllocatedSize() + RootKinds.GetAllocatedSize() + VisitStamps.GetAllocatedSize()
+		+ OverriddenSources.GetAllocatedSize() + OverlayOutEdges.GetAllocatedSize() + OverlayInEdges.GetAllocatedSize()
+		+ NumOverlayEdges * 2 * sizeof(FObjRefOverlayEdge);
+}
+
+bool FObjRefReferenceGraph::FindShortestPathsToRoot(int32 TargetIndex, int32 MaxPaths, TArray<TArray<FObjRefPathStep>>& OutPaths, const FObjRefJobToken& CancelToken) const
+{
+	OutPaths.Reset();
+
+	FRWScopeLock ReadLock(GraphLock, SLT_ReadOnly);
+	FScopeLock Lock(&SearchLock);
+
+	const int32 NumObjects = GetNumObjects();
+	if (TargetIndex < 0 || TargetIndex >= NumObjects || MaxPaths <= 0)
+	{
+		return false;
+	}
+
+	if (VisitStamps.Num() != NumObjects)
+	{
+		VisitStamps.Reset();
+		VisitStamps.SetNumZeroed(NumObjects);
+		CurrentVisitStamp = 0;
+	}
+	if (++CurrentVisitStamp == 0)
+	{
+		// 序号回绕时清零一次
+		FMemory::Memzero(VisitStamps.GetData(), VisitStamps.Num() * sizeof(uint32));
+		CurrentVisitStamp = 1;
+	}
+
+	// BFS 队列本身就是访问记录：Queue[i] 的父节点为 Queue[ParentSlots[i]]，由 PropertyIds[i] 引用父节点
+	TArray<int32> Queue;
+	TArray<int32> ParentSlots;
+	TArray<int32> PropertyIds;
+	Queue.Add(TargetIndex);
+	ParentSlots.Add(INDEX_NONE);
+	PropertyIds.Add(INDEX_NONE);
+	VisitStamps[TargetIndex] = CurrentVisitStamp;
+
+	TArray<int32> RootSlots;
+	int32 LevelBegin = 0;
+	while (LevelBegin < Queue.Num() && RootSlots.Num() == 0)
+	{
+		const int32 LevelEnd = Queue.Num();
+
+		// 先检查整层，保证找到的所有根都位于最短距离上
+		for (int32 Slot = LevelBegin; Slot < LevelEnd && RootSlots.Num() < MaxPaths; ++Slot)
+		{
+			if (GetRootKind(Queue[Slot]) != EObjRefRootKind::None)
+			{
+				RootSlots.Add(Slot);
+			}
+		}
+		if (RootSlots.Num() > 0)
+		{
+			break;
+		}
+
+		// 扩展下一层：沿反向边走向引用者
+		for (int32 Slot = LevelBegin; Slot < LevelEnd; ++Slot)
+		{
+			if ((Slot % NodesPerCancelCheck) == 0 && CancelToken.IsCancelled())
+			{
+				return false;
+			}
+
+			ForEachReferencer(Queue[Slot], [this, Slot, &Queue, &ParentSlots, &PropertyIds](int32 SourceIndex, int32 PropertyId)
+			{
+				if (VisitStamps[SourceIndex] != CurrentVisitStamp)
+				{
+					VisitStamps[SourceIndex] = CurrentVisitStamp;
+					Queue.Add(SourceIndex);
+					ParentSlots.Add(Slot);
+					PropertyIds.Add(PropertyId);
+				}
+			});
+		}
+
+		LevelBegin = LevelEnd;
+	}
+
+	// 沿父节点数组回溯，得到从目标到根的路径
+	for (int32 RootSlot : RootSlots)
+	{
+		TArray<FObjRefPathStep> ReversedPath;
+		for (int32 Slot = RootSlot; Slot != INDEX_NONE; Slot = ParentSlots[Slot])
+		{
+			ReversedPath.Emplace(Queue[Slot], PropertyIds[Slot]);
+		}
+
+		TArray<FObjRefPathStep>& Path = OutPaths.AddDefaulted_GetRef();
+		Path.Reserve(ReversedPath.Num());
+		for (int32 StepIndex = ReversedPath.Num() - 1; StepIndex >= 0; --StepIndex)
+		{
+			Path.Add(ReversedPath[StepIndex]);
+		}
+	}
+
+	return OutPaths.Num() > 0;
+}
+
+UObject* FObjRefReferenceGraph::GetObjectByIndex(int32 ObjectIndex)
+{
+	if (ObjectIndex < 0 || ObjectIndex >= GUObjectArray.GetObjectArrayNum())
+	{
+		return nullptr;
+	}
+
+	FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+	if (!ObjectItem || !ObjectItem->Object || ObjectItem->IsUnreachable())
+	{
+		return nullptr;
+	}
+
+	return static_cast<UObject*>(ObjectItem->Object);
+}
+
+void FObjRefReferenceGraph::OnPostGarbageCollect()
+{
+	// 具体的变化已经由删除监听记录，这里只推进GC周期
+	++GCEpoch;
+}
+
+void FObjRefReferenceGraph::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// 通知可能来自异步加载线程，bHasSnapshot 为原子变量；没有快照时不需要记录
+	if (!bHasSnapshot)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PendingLock);
+	PendingDirtyObjects.Add(Index);
+
+	// 新对象通常由它的 Outer 持有，构造时还无法看到这条引用，把 Outer 也标记为脏
+	if (const UObjectBase* Outer = Object->GetOuter())
+	{
+		PendingDirtyObjects.Add(GUObjectArray.ObjectToIndex(Outer));
+	}
+}
+
+void FObjRefReferenceGraph::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	if (!bHasSnapshot)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PendingLock);
+	PendingDeletedObjects.Add(Index);
+}
+
+void FObjRefReferenceGraph::OnUObjectArrayShutdown()
+{
+	UnregisterListeners();
+}
@@ -0,0 +1,456 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerSnapshot.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/GarbageCollection.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Algo/BinarySearch.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "快照文件按小端序直接写出内存中的数组");
+
+namespace ObjRefSnapshot
+{
+	const uint64 SectionAlignment = 8;
+
+	/** 按顺序为各段分配对齐的文件偏移 */
+	struct FLayout
+	{
+		uint64 Offset = sizeof(FObjRefSnapshotHeader);
+
+		uint64 Place(uint64 Bytes)
+		{
+			const uint64 Start = Align(Offset, SectionAlignment);
+			Offset = Start + Bytes;
+			return Start;
+		}
+	};
+
+	/** 去重的 UTF-8 字符串表 */
+	struct FStringTable
+	{
+		TArray<uint32> Offsets;
+		TArray<ANSICHAR> Data;
+
+		int32 Add(const FString& String)
+		{
+			FTCHARToUTF8 Utf8(*String);
+			Offsets.Add(static_cast<uint32>(Data.Num()));
+			Data.Append(reinterpret_cast<const ANSICHAR*>(Utf8.Get()), Utf8.Length());
+			Data.Add('\0');
+			return Offsets.Num() - 1;
+		}
+	};
+
+	/** 补零到段的起始偏移后写出整段 */
+	static void WriteSection(FArchive& Ar, uint64 SectionOffset, const void* SectionData, uint64 Bytes)
+	{
+		static const uint8 Zeros[SectionAlignment] = {};
+		const uint64 Padding = SectionOffset - static_cast<uint64>(Ar.Tell());
+		check(Padding < SectionAlignment);
+		Ar.Serialize(const_cast<uint8*>(Zeros), Padding);
+		if (Bytes > 0)
+		{
+			Ar.Serialize(const_cast<void*>(SectionData), Bytes);
+		}
+	}
+
+	/** 段是否完整位于文件内且满足对齐 */
+	static bool IsSectionValid(uint64 SectionOffset, uint64 Bytes, uint64 FileSize)
+	{
+		return SectionOffset % SectionAlignment == 0 && SectionOffset <= FileSize && Bytes <= FileSize - SectionOffset;
+	}
+
+	/** 字符串偏移单调不减且不超出数据段，每个字符串非空且以 0 结尾 */
+	static bool AreStringsValid(const uint32* Offsets, uint32 NumStrings, const ANSICHAR* Data, uint64 DataSize)
+	{
+		for (uint32 StringId = 0; StringId < NumStrings; ++StringId)
+		{
+			const uint32 Begin = Offsets[StringId];
+			const uint32 End = Offsets[StringId + 1];
+			if (Begin >= End || End > DataSize || Data[End - 1] != '\0')
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** 记录中的字符串下标与 Outer 下标在范围内，且按对象索引严格升序（FindRecord 二分查找依赖这一点） */
+	static bool AreRecordsValid(const FObjRefSnapshotRecord* Records, uint32 NumRecords, uint32 NumStrings)
+	{
+		for (uint32 RecordIndex = 0; RecordIndex < NumRecords; ++RecordIndex)
+		{
+			const FObjRefSnapshotRecord& Record = Records[RecordIndex];
+			if (Record.NameId < 0 || static_cast<uint32>(Record.NameId) >= NumStrings
+				|| Record.ClassId < 0 || static_cast<uint32>(Record.ClassId) >= NumStrings
+				|| (Record.OuterRecord != INDEX_NONE && (Record.OuterRecord < 0 || static_cast<uint32>(Record.OuterRecord) >= NumRecords))
+				|| (RecordIndex > 0 && Records[RecordIndex - 1].ObjectIndex >= Record.ObjectIndex))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** 边偏移单调不减且不超出边数，单个记录的出边数能用 int32 表示，边目标都是有效的记录下标 */
+	static bool AreEdgesValid(const uint64* Offsets, const int32* Targets, uint32 NumRecords, uint64 NumEdges)
+	{
+		for (uint32 RecordIndex = 0; RecordIndex < NumRecords; ++RecordIndex)
+		{
+			const uint64 Begin = Offsets[RecordIndex];
+			const uint64 End = Offsets[RecordIndex + 1];
+			if (Begin > End || End > NumEdges || End - Begin > static_cast<uint64>(MAX_int32))
+			{
+				return false;
+			}
+		}
+
+		for (uint64 EdgeIndex = 0; EdgeIndex < NumEdges; ++EdgeIndex)
+		{
+			if (Targets[EdgeIndex] < 0 || static_cast<uint32>(Targets[EdgeIndex]) >= NumRecords)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void CaptureFromConsole(const TArray<FString>& Args)
+	{
+		const FString Path = Args.Num() > 0 ? Args[0] : FObjRefSnapshotWriter::MakeDefaultPath();
+
+		// 没有打开调试器窗口时没有现成的引用图，临时完整构建一次
+		FObjRefReferenceGraph Graph;
+		Graph.Rebuild(EObjRefGraphBuildMode::Parallel);
+
+		FObjRefSnapshotHeader Header;
+		FString Error;
+		if (FObjRefSnapshotWriter::Capture(Graph, Path, Header, Error))
+		{
+			UE_LOG(LogTemp, Display, TEXT("堆快照已写入 %s"), *Path);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("堆快照捕获失败: %s"), *Error);
+		}
+	}
+
+	static FAutoConsoleCommand CaptureSnapshotCommand(
+		TEXT("ObjRefDebugger.CaptureSnapshot"),
+		TEXT("捕获堆快照（所有对象与强引用边）并写入文件。用法: ObjRefDebugger.CaptureSnapshot [路径]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CaptureFromConsole));
+}
+
+bool FObjRefSnapshotWriter::Capture(FObjRefReferenceGraph& Graph, const FString& Path, FObjRefSnapshotHeader& OutHeader, FString& OutError)
+{
+	using namespace ObjRefSnapshot;
+
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Graph.EnsureUpToDate();
+
+	// 捕获期间阻止GC，对象数组中的对象和引用图保持一致
+	FGCScopeGuard GCGuard;
+
+	const int32 NumSlots = GUObjectArray.GetObjectArrayNum();
+
+	// 第一遍：为每个可达对象分配记录下标，名称与类路径驻留到字符串表，Outer 暂存为对象索引
+	TArray<int32> RecordByObject;
+	RecordByObject.Init(INDEX_NONE, NumSlots);
+
+	TArray<FObjRefSnapshotRecord> Records;
+	Records.Reserve(GUObjectArray.GetObjectArrayNumMinusAvailable());
+
+	FStringTable Strings;
+	TMap<FName, int32> NameIds;
+	TMap<const UClass*, int32> ClassIds;
+
+	for (int32 ObjectIndex = 0; ObjectIndex < NumSlots; ++ObjectIndex)
+	{
+		UObject* Object = FObjRefReferenceGraph::GetObjectByIndex(ObjectIndex);
+		if (!Object)
+		{
+			continue;
+		}
+
+		RecordByObject[ObjectIndex] = Records.Num();
+
+		const FName Name = Object->GetFName();
+		int32* NameId = NameIds.Find(Name);
+		if (!NameId)
+		{
+			NameId = &NameIds.Add(Name, Strings.Add(Name.ToString()));
+		}
+
+		const UClass* Class = Object->GetClass();
+		int32* ClassId = ClassIds.Find(Class);
+		if (!ClassId)
+		{
+			ClassId = &ClassIds.Add(Class, Strings.Add(Class->GetPathName()));
+		}
+
+		FObjRefSnapshotRecord& Record = Records.AddZeroed_GetRef();
+		Record.ObjectIndex = ObjectIndex;
+		Record.NameId = *NameId;
+		Record.ClassId = *ClassId;
+		Record.OuterRecord = Object->GetOuter() ? GUObjectArray.ObjectToIndex(Object->GetOuter()) : INDEX_NONE;
+		Record.ObjectFlags = static_cast<uint32>(Object->GetFlags());
+		Record.RootKind = static_cast<uint8>(Graph.GetRootKind(ObjectIndex));
+		Record.Size = Class->GetStructureSize();
+	}
+
+	// 第二遍：Outer 换成记录下标，出边按记录顺序展开为 CSR
+	TArray<uint64> EdgeOffsets;
+	EdgeOffsets.Reserve(Records.Num() + 1);
+	TArray<int32> EdgeTargets;
+	EdgeTargets.Reserve(Graph.GetNumEdges());
+
+	for (FObjRefSnapshotRecord& Record : Records)
+	{
+		Record.OuterRecord = RecordByObject.IsValidIndex(Record.OuterRecord) ? RecordByObject[Record.OuterRecord] : INDEX_NONE;
+
+		EdgeOffsets.Add(static_cast<uint64>(EdgeTargets.Num()));
+		Graph.ForEachReference(Record.ObjectIndex, [&RecordByObject, &EdgeTargets](int32 TargetIndex)
+		{
+			if (RecordByObject.IsValidIndex(TargetIndex) && RecordByObject[TargetIndex] != INDEX_NONE)
+			{
+				EdgeTargets.Add(RecordByObject[TargetIndex]);
+			}
+		});
+	}
+	EdgeOffsets.Add(static_cast<uint64>(EdgeTargets.Num()));
+	Strings.Offsets.Add(static_cast<uint32>(Strings.Data.Num()));
+
+	if (static_cast<uint64>(Strings.Data.Num()) > MAX_uint32)
+	{
+		OutError = TEXT("字符串表超过 4GB");
+		return false;
+	}
+
+	// 各段大小都已确定，先算出布局再顺序写出
+	FObjRefSnapshotHeader& Header = OutHeader;
+	FMemory::Memzero(Header);
+	Header.Magic = FObjRefSnapshotHeader::ExpectedMagic;
+	Header.Version = FObjRefSnapshotHeader::CurrentVersion;
+	Header.HeaderSize = sizeof(FObjRefSnapshotHeader);
+	Header.RecordSize = sizeof(FObjRefSnapshotRecord);
+	Header.CaptureTime = FDateTime::UtcNow().GetTicks();
+	Header.NumRecords = static_cast<uint32>(Records.Num());
+	Header.NumStrings = static_cast<uint32>(Strings.Offsets.Num() - 1);
+	Header.NumEdges = static_cast<uint64>(EdgeTargets.Num());
+
+	FLayout Layout;
+	Header.StringOffsetsOffset = Layout.Place(Strings.Offsets.Num() * sizeof(uint32));
+	Header.StringDataOffset = Layout.Place(Strings.Data.Num());
+	Header.StringDataSize = Strings.Data.Num();
+	Header.RecordsOffset = Layout.Place(Records.Num() * sizeof(FObjRefSnapshotRecord));
+	Header.EdgeOffsetsOffset = Layout.Place(EdgeOffsets.Num() * sizeof(uint64));
+	Header.EdgeTargetsOffset = Layout.Place(EdgeTargets.Num() * sizeof(int32));
+	Header.FileSize = Layout.Offset;
+
+	const FString TempPath = Path + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+		{
+			OutError = FString::Printf(TEXT("无法创建文件 %s"), *TempPath);
+			return false;
+		}
+
+		Writer->Serialize(&Header, sizeof(Header));
+		WriteSection(*Writer, Header.StringOffsetsOffset, Strings.Offsets.GetData(), Strings.Offsets.Num() * sizeof(uint32));
+		WriteSection(*Writer, Header.StringDataOffset, Strings.Data.GetData(), Strings.Data.Num());
+		WriteSection(*Writer, Header.RecordsOffset, Records.GetData(), Records.Num() * sizeof(FObjRefSnapshotRecord));
+		WriteSection(*Writer, Header.EdgeOffsetsOffset, EdgeOffsets.GetData(), EdgeOffsets.Num() * sizeof(uint64));
+		WriteSection(*Writer, Header.EdgeTargetsOffset, EdgeTargets.GetData(), EdgeTargets.Num() * sizeof(int32));
+
+		const bool bWriteFailed = Writer->IsError();
+		if (!Writer->Close() || bWriteFailed)
+		{
+			IFileManager::Get().Delete(*TempPath);
+			OutError = FString::Printf(TEXT("写入文件 %s 失败"), *TempPath);
+			return false;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		OutError = FString::Printf(TEXT("无法把临时文件改名为 %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("堆快照: %d 个对象, %llu 条边, %d 个字符串, %.1f MB, 用时 %.3f 秒"),
+		Records.Num(), Header.NumEdges, Header.NumStrings, Header.FileSize / (1024.0 * 1024.0), FPlatformTime::Seconds() - StartTime);
+	return true;
+}
+
+FString FObjRefSnapshotWriter::MakeDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ObjRefSnapshots"),
+		FString::Printf(TEXT("Snapshot_%s.%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), GetFileExtension()));
+}
+
+FObjRefSnapshotView::FObjRefSnapshotView()
+	: Data(nullptr)
+	, StringOffsets(nullptr)
+	, StringData(nullptr)
+	, Records(nullptr)
+	, EdgeOffsets(nullptr)
+	, EdgeTargets(nullptr)
+{
+}
+
+FObjRefSnapshotView::~FObjRefSnapshotView()
+{
+	Close();
+}
+
+void FObjRefSnapshotView::Close()
+{
+	// 映射区域必须先于文件句柄释放
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackBuffer.Empty();
+
+	Data = nullptr;
+	StringOffsets = nullptr;
+	StringData = nullptr;
+	Records = nullptr;
+	EdgeOffsets = nullptr;
+	EdgeTargets = nullptr;
+}
+
+bool FObjRefSnapshotView::Open(const FString& Path, FString& OutError)
+{
+	Close();
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+	if (MappedHandle)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion());
+	}
+
+	if (MappedRegion)
+	{
+		if (Bind(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), OutError))
+		{
+			return true;
+		}
+	}
+	else
+	{
+		// 平台不支持内存映射，整体读入内存
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackBuffer, *Path))
+		{
+			OutError = FString::Printf(TEXT("无法打开文件 %s"), *Path);
+			return false;
+		}
+		if (Bind(FallbackBuffer.GetData(), FallbackBuffer.Num(), OutError))
+		{
+			return true;
+		}
+	}
+
+	Close();
+	return false;
+}
+
+bool FObjRefSnapshotView::Bind(const uint8* InData, int64 InSize, FString& OutError)
+{
+	using namespace ObjRefSnapshot;
+
+	if (!InData || InSize < static_cast<int64>(sizeof(FObjRefSnapshotHeader)))
+	{
+		OutError = TEXT("文件过小，不是快照文件");
+		return false;
+	}
+
+	const FObjRefSnapshotHeader& Header = *reinterpret_cast<const FObjRefSnapshotHeader*>(InData);
+	if (Header.Magic != FObjRefSnapshotHeader::ExpectedMagic)
+	{
+		OutError = TEXT("文件标识不匹配，不是快照文件");
+		return false;
+	}
+	if (Header.Version != FObjRefSnapshotHeader::CurrentVersion
+		|| Header.HeaderSize != sizeof(FObjRefSnapshotHeader)
+		|| Header.RecordSize != sizeof(FObjRefSnapshotRecord))
+	{
+		OutError = FString::Printf(TEXT("不支持的快照版本 %u"), Header.Version);
+		return false;
+	}
+
+	const uint64 FileSize = static_cast<uint64>(InSize);
+	if (Header.FileSize != FileSize
+		|| Header.NumRecords > static_cast<uint32>(MAX_int32)
+		|| Header.NumStrings > static_cast<uint32>(MAX_int32)
+		|| !IsSectionValid(Header.StringOffsetsOffset, (static_cast<uint64>(Header.NumStrings) + 1) * sizeof(uint32), FileSize)
+		|| !IsSectionValid(Header.StringDataOffset, Header.StringDataSize, FileSize)
+		|| !IsSectionValid(Header.RecordsOffset, static_cast<uint64>(Header.NumRecords) * sizeof(FObjRefSnapshotRecord), FileSize)
+		|| !IsSectionValid(Header.EdgeOffsetsOffset, (static_cast<uint64>(Header.NumRecords) + 1) * sizeof(uint64), FileSize)
+		|| Header.NumEdges > FileSize / sizeof(int32)
+		|| !IsSectionValid(Header.EdgeTargetsOffset, Header.NumEdges * sizeof(int32), FileSize))
+	{
+		OutError = TEXT("快照文件已损坏：段超出文件范围");
+		return false;
+	}
+
+	const uint32* InStringOffsets = reinterpret_cast<const uint32*>(InData + Header.StringOffsetsOffset);
+	const ANSICHAR* InStringData = reinterpret_cast<const ANSICHAR*>(InData + Header.StringDataOffset);
+	const FObjRefSnapshotRecord* InRecords = reinterpret_cast<const FObjRefSnapshotRecord*>(InData + Header.RecordsOffset);
+	const uint64* InEdgeOffsets = reinterpret_cast<const uint64*>(InData + Header.EdgeOffsetsOffset);
+	const int32* InEdgeTargets = reinterpret_cast<const int32*>(InData + Header.EdgeTargetsOffset);
+	if (InStringOffsets[Header.NumStrings] != Header.StringDataSize || InEdgeOffsets[Header.NumRecords] != Header.NumEdges)
+	{
+		OutError = TEXT("快照文件已损坏：偏移表与数据长度不一致");
+		return false;
+	}
+
+	// 读取接口直接按记录中的值索引各段，打开时线性检查一遍，损坏的文件不会导致越界读取
+	if (!AreStringsValid(InStringOffsets, Header.NumStrings, InStringData, Header.StringDataSize))
+	{
+		OutError = TEXT("快照文件已损坏：字符串表无效");
+		return false;
+	}
+	if (!AreRecordsValid(InRecords, Header.NumRecords, Header.NumStrings))
+	{
+		OutError = TEXT("快照文件已损坏：对象记录无效");
+		return false;
+	}
+	if (!AreEdgesValid(InEdgeOffsets, InEdgeTargets, Header.NumRecords, Header.NumEdges))
+	{
+		OutError = TEXT("快照文件已损坏：引用边无效");
+		return false;
+	}
+
+	Data = InData;
+	StringOffsets = InStringOffsets;
+	StringData = InStringData;
+	Records = InRecords;
+	EdgeOffsets = InEdgeOffsets;
+	EdgeTargets = InEdgeTargets;
+	return true;
+}
+
+TArrayView<const int32> FObjRefSnapshotView::GetReferences(int32 RecordIndex) const
+{
+	const uint64 Begin = EdgeOffsets[RecordIndex];
+	const uint64 End = EdgeOffsets[RecordIndex + 1];
+	return TArrayView<const int32>(EdgeTargets + Begin, static_cast<int32>(End - Begin));
+}
+
+int32 FObjRefSnapshotView::FindRecord(int32 ObjectIndex) const
+{
+	const int32 RecordIndex = Algo::LowerBoundBy(TArrayView<const FObjRefSnapshotRecord>(Records, Num()), ObjectIndex,
+		[](const FObjRefSnapshotRecord& Record) { return Record.ObjectIndex; });
+	return RecordIndex < Num() && Records[RecordIndex].ObjectIndex == ObjectIndex ? RecordIndex : INDEX_NONE;
+}
@@ -0,0 +1,331 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerTrigramIndex.h"
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerParallelSort.h"
+#include "UObject/UObjectArray.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	typedef TArray<uint32, TInlineAllocator<64>> FTrigramList;
+
+	uint32 EncodeTrigram(const TCHAR* Chars)
+	{
+		return ((Chars[0] & 0x7F) << 14) | ((Chars[1] & 0x7F) << 7) | (Chars[2] & 0x7F);
+	}
+
+	/** 收集字符串中不重复的三元组，升序排列 */
+	void CollectTrigrams(const TCHAR* Chars, int32 Length, FTrigramList& OutTrigrams)
+	{
+		OutTrigrams.Reset();
+		for (int32 Index = 0; Index + 2 < Length; ++Index)
+		{
+			OutTrigrams.Add(EncodeTrigram(Chars + Index));
+		}
+
+		Algo::Sort(OutTrigrams);
+		int32 NumUnique = 0;
+		for (int32 Index = 0; Index < OutTrigrams.Num(); ++Index)
+		{
+			if (NumUnique == 0 || OutTrigrams[NumUnique - 1] != OutTrigrams[Index])
+			{
+				OutTrigrams[NumUnique++] = OutTrigrams[Index];
+			}
+		}
+		OutTrigrams.SetNum(NumUnique, false);
+	}
+
+	/** 两个升序的文档列表求交集，结果写回 InOutDocuments */
+	void IntersectDocuments(TArray<int32>& InOutDocuments, TArrayView<const int32> Other)
+	{
+		int32 NumKept = 0;
+
+		// 候选远少于另一张表时逐个二分查找，否则线性归并
+		if (InOutDocuments.Num() * 8 < Other.Num())
+		{
+			for (int32 Document : InOutDocuments)
+			{
+				if (Algo::BinarySearch(Other, Document) != INDEX_NONE)
+				{
+					InOutDocuments[NumKept++] = Document;
+				}
+			}
+		}
+		else
+		{
+			int32 OtherIndex = 0;
+			for (int32 Document : InOutDocuments)
+			{
+				while (OtherIndex < Other.Num() && Other[OtherIndex] < Document)
+				{
+					++OtherIndex;
+				}
+				if (OtherIndex < Other.Num() && Other[OtherIndex] == Document)
+				{
+					InOutDocuments[NumKept++] = Document;
+				}
+			}
+		}
+
+		InOutDocuments.SetNum(NumKept, false);
+	}
+
+	/** 不经过索引判断字符串是否匹配已转为小写的查询串 */
+	bool MatchString(const FString& String, const FString& LowerText, bool bPrefix)
+	{
+		return bPrefix ? String.StartsWith(LowerText) : String.Contains(LowerText);
+	}
+}
+
+FObjRefTrigramIndex::FObjRefTrigramIndex()
+{
+}
+
+void FObjRefTrigramIndex::Build(const TArray<FString>& Documents)
+{
+	// 所有文档以小写连续存放，文档之间以 '\0' 分隔
+	int32 PoolSize = 0;
+	for (const FString& Document : Documents)
+	{
+		PoolSize += Document.Len() + 1;
+	}
+
+	Pool.Reset(PoolSize);
+	DocumentOffsets.Reset(Documents.Num() + 1);
+	for (const FString& Document : Documents)
+	{
+		DocumentOffsets.Add(Pool.Num());
+		for (TCHAR Char : Document)
+		{
+			Pool.Add(FChar::ToLower(Char));
+		}
+		Pool.Add(TEXT('\0'));
+	}
+	DocumentOffsets.Add(Pool.Num());
+
+	// 每个（三元组，文档）对编码为一个 64 位键，排序后同一三元组的文档连续且按文档ID升序，
+	// 偏移表只为实际出现的三元组分配，大小与文档内容成正比
+	TArray<uint64> Pairs;
+	Pairs.Reserve(PoolSize);
+
+	FTrigramList Trigrams;
+	for (int32 DocumentId = 0; DocumentId < Documents.Num(); ++DocumentId)
+	{
+		CollectTrigrams(GetDocument(DocumentId), Documents[DocumentId].Len(), Trigrams);
+		for (uint32 Trigram : Trigrams)
+		{
+			Pairs.Add((static_cast<uint64>(Trigram) << 32) | static_cast<uint32>(DocumentId));
+		}
+	}
+	ObjRefParallelSort(Pairs, TLess<uint64>());
+
+	TrigramKeys.Reset();
+	TrigramOffsets.Reset();
+	Postings.Reset();
+	Postings.SetNumUninitialized(Pairs.Num());
+	for (int32 PairIndex = 0; PairIndex < Pairs.Num(); ++PairIndex)
+	{
+		const uint32 Trigram = static_cast<uint32>(Pairs[PairIndex] >> 32);
+		if (TrigramKeys.Num() == 0 || TrigramKeys.Last() != Trigram)
+		{
+			TrigramKeys.Add(Trigram);
+			TrigramOffsets.Add(PairIndex);
+		}
+		Postings[PairIndex] = static_cast<int32>(Pairs[PairIndex] & 0xFFFFFFFF);
+	}
+	TrigramOffsets.Add(Pairs.Num());
+
+	TrigramKeys.Shrink();
+	TrigramOffsets.Shrink();
+}
+
+void FObjRefTrigramIndex::FindDocuments(const FString& LowerQuery, bool bPrefix, TArray<int32>& OutDocuments) const
+{
+	OutDocuments.Reset();
+
+	// 查询太短时没有三元组可用，直接扫描字符串池
+	if (LowerQuery.Len() < 3)
+	{
+		for (int32 DocumentId = 0; DocumentId < NumDocuments(); ++DocumentId)
+		{
+			if (MatchDocument(DocumentId, LowerQuery, bPrefix))
+			{
+				OutDocuments.Add(DocumentId);
+			}
+		}
+		return;
+	}
+
+	FTrigramList Trigrams;
+	CollectTrigrams(*LowerQuery, LowerQuery.Len(), Trigrams);
+
+	// 从最短的文档列表开始求交集，候选集合只会越来越小；任一三元组没有出现过时不可能匹配
+	TArray<TArrayView<const int32>, TInlineAllocator<64>> Lists;
+	for (uint32 Trigram : Trigrams)
+	{
+		const int32 KeyIndex = Algo::BinarySearch(TrigramKeys, Trigram);
+		if (KeyIndex == INDEX_NONE)
+		{
+			return;
+		}
+		Lists.Add(MakeArrayView(Postings.GetData() + TrigramOffsets[KeyIndex], TrigramOffsets[KeyIndex + 1] - TrigramOffsets[KeyIndex]));
+	}
+	Algo::SortBy(Lists, [](const TArrayView<const int32>& List) { return List.Num(); });
+
+	TArray<int32> Candidates(Lists[0].GetData(), Lists[0].Num());
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && Candidates.Num() > 0; ++ListIndex)
+	{
+		IntersectDocuments(Candidates, Lists[ListIndex]);
+	}
+
+	// 三元组都出现不代表连续出现，候选还需要在字符串池中验证
+	for (int32 DocumentId : Candidates)
+	{
+		if (MatchDocument(DocumentId, LowerQuery, bPrefix))
+		{
+			OutDocuments.Add(DocumentId);
+		}
+	}
+}
+
+SIZE_T FObjRefTrigramIndex::GetAllocatedSize() const
+{
+	return Pool.GetAllocatedSize() + DocumentOffsets.GetAllocatedSize() + TrigramKeys.GetAllocatedSize()
+		+ TrigramOffsets.GetAllocatedSize() + Postings.GetAllocatedSize();
+}
+
+bool FObjRefTrigramIndex::MatchDocument(int32 DocumentId, const FString& LowerQuery, bool bPrefix) const
+{
+	const TCHAR* Document = GetDocument(DocumentId);
+	return bPrefix ?
+		FCString::Strncmp(Document, *LowerQuery, LowerQuery.Len()) == 0 :
+		FCString::Strstr(Document, *LowerQuery) != nullptr;
+}
+
+FObjRefNameIndex::FObjRefNameIndex()
+	: bIsValid(false)
+{
+}
+
+void FObjRefNameIndex::Build(const FObjRefInstanceTable& Table)
+{
+	const int32 NumRows = Table.Num();
+
+	TArray<FString> Names;
+	Names.SetNum(NumRows);
+	TArray<int32> OuterObjectIndices;
+	OuterObjectIndices.SetNumUninitialized(NumRows);
+	ParallelFor(NumRows, [&Table, &Names, &OuterObjectIndices](int32 Row)
+	{
+		UObject* Object = Table.ResolveRow(Row);
+		UObject* Outer = Object ? Object->GetOuter() : nullptr;
+		if (Object)
+		{
+			Names[Row] = Object->GetName();
+		}
+		OuterObjectIndices[Row] = Outer ? GUObjectArray.ObjectToIndex(Outer) : INDEX_NONE;
+	});
+
+	// 同一 Outer 下的对象共用一条路径，只为不同的 Outer 生成一次路径名
+	TMap<int32, int32> OuterIdByObjectIndex;
+	TArray<FString> OuterPaths;
+	OuterIdOfRow.SetNumUninitialized(NumRows);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const int32 OuterObjectIndex = OuterObjectIndices[Row];
+		if (OuterObjectIndex == INDEX_NONE)
+		{
+			OuterIdOfRow[Row] = INDEX_NONE;
+			continue;
+		}
+
+		if (const int32* ExistingId = OuterIdByObjectIndex.Find(OuterObjectIndex))
+		{
+			OuterIdOfRow[Row] = *ExistingId;
+			continue;
+		}
+
+		const UObject* Outer = static_cast<const UObject*>(GUObjectArray.IndexToObject(OuterObjectIndex)->Object);
+		const int32 OuterId = OuterPaths.Add(Outer->GetPathName());
+		OuterIdByObjectIndex.Add(OuterObjectIndex, OuterId);
+		OuterIdOfRow[Row] = OuterId;
+	}
+
+	NameIndex.Build(Names);
+	OuterPathIndex.Build(OuterPaths);
+	bIsValid = true;
+}
+
+void FObjRefNameIndex::MatchRows(const FString& Query, TArray<uint8>& OutRowMatches) const
+{
+	const int32 NumRows = OuterIdOfRow.Num();
+	OutRowMatches.Reset();
+	OutRowMatches.SetNumZeroed(NumRows);
+
+	FString LowerText;
+	bool bPrefix = false;
+	ParseQuery(Query, LowerText, bPrefix);
+	if (LowerText.IsEmpty())
+	{
+		FMemory::Memset(OutRowMatches.GetData(), 1, NumRows);
+		return;
+	}
+
+	// 名称索引的文档ID就是行号
+	TArray<int32> Documents;
+	NameIndex.FindDocuments(LowerText, bPrefix, Documents);
+	for (int32 Row : Documents)
+	{
+		OutRowMatches[Row] = 1;
+	}
+
+	OuterPathIndex.FindDocuments(LowerText, bPrefix, Documents);
+	if (Documents.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8> OuterMatches;
+	OuterMatches.SetNumZeroed(OuterPathIndex.NumDocuments());
+	for (int32 OuterId : Documents)
+	{
+		OuterMatches[OuterId] = 1;
+	}
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		if (OuterIdOfRow[Row] != INDEX_NONE && OuterMatches[OuterIdOfRow[Row]])
+		{
+			OutRowMatches[Row] = 1;
+		}
+	}
+}
+
+void FObjRefNameIndex::ParseQuery(const FString& Query, FString& OutLowerText, bool& bOutPrefix)
+{
+	OutLowerText = Query.TrimStartAndEnd();
+	bOutPrefix = OutLowerText.StartsWith(TEXT("^"));
+	if (bOutPrefix)
+	{
+		OutLowerText = OutLowerText.RightChop(1);
+	}
+	OutLowerText.ToLowerInline();
+}
+
+bool FObjRefNameIndex::MatchObject(const UObject* Object, const FString& LowerText, bool bPrefix)
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	const UObject* Outer = Object->GetOuter();
+	return MatchString(Object->GetName(), LowerText, bPrefix) || (Outer && MatchString(Outer->GetPathName(), LowerText, bPrefix));
+}
+
+SIZE_T FObjRefNameIndex::GetAllocatedSize() const
+{
+	return NameIndex.GetAllocatedSize() + OuterPathIndex.GetAllocatedSize() + OuterIdOfRow.GetAllocatedSize();
+}
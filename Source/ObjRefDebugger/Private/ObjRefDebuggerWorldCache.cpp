@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ObjRefDebuggerWorldCache.h"
+#include "UObject/UObjectArray.h"
+#include "Engine/World.h"
+
+namespace
+{
+	const int32 UnresolvedEntry = 0;
+	const int32 NoWorldEntry = 1;
+
+	int32 EncodeWorld(const UWorld* World)
+	{
+		return World ? GUObjectArray.ObjectToIndex(World) + 2 : NoWorldEntry;
+	}
+}
+
+FObjRefWorldCache::FObjRefWorldCache()
+{
+}
+
+void FObjRefWorldCache::Reset()
+{
+	WorldByOuter.Reset();
+	WorldByOuter.SetNumZeroed(GUObjectArray.GetObjectArrayNum());
+}
+
+int32 FObjRefWorldCache::GetWorldIndex(const UObject* Object)
+{
+	if (Object->GetClass()->HasAnyCastFlag(CASTCLASS_UWorld))
+	{
+		return GUObjectArray.ObjectToIndex(Object);
+	}
+
+	UObject* Outer = Object->GetOuter();
+	if (!Outer)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 OuterIndex = GUObjectArray.ObjectToIndex(Outer);
+	int32 Entry = UnresolvedEntry;
+	if (WorldByOuter.IsValidIndex(OuterIndex))
+	{
+		Entry = FPlatformAtomics::AtomicRead(&WorldByOuter[OuterIndex]);
+		if (Entry == UnresolvedEntry)
+		{
+			// 多个线程可能同时解析同一个 Outer，写入的值相同
+			Entry = EncodeWorld(Outer->GetWorld());
+			FPlatformAtomics::AtomicStore(&WorldByOuter[OuterIndex], Entry);
+		}
+	}
+	else
+	{
+		// 缓存建立之后新建的 Outer 不在表中，直接解析
+		Entry = EncodeWorld(Outer->GetWorld());
+	}
+
+	return Entry == NoWorldEntry ? INDEX_NONE : Entry - 2;
+}
+
+UWorld* FObjRefWorldCache::GetWorld(const UObject* Object)
+{
+	const int32 WorldIndex = GetWorldIndex(Object);
+	if (WorldIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FUObjectItem* WorldItem = GUObjectArray.IndexToObject(WorldIndex);
+	return WorldItem ? static_cast<UWorld*>(static_cast<UObject*>(WorldItem->Object)) : nullptr;
+}
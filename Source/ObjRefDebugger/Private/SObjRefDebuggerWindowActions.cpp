@@ -1,6 +1,18 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SObjRefDebuggerWindow.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "ObjRefDebuggerDominatorTree.h"
+#include "ObjRefDebuggerMemorySizeCache.h"
+#include "ObjRefDebuggerCondensedGraph.h"
+#include "ObjRefDebuggerClassIndex.h"
+#include "ObjRefDebuggerAnalysisCache.h"
+#include "ObjRefDebuggerSnapshot.h"
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerInstanceView.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/DateTime.h"
@@ -10,12 +22,29 @@
 #include "DesktopPlatformModule.h"
 #include "IDesktopPlatform.h"
 #include "EditorDirectories.h"
-#include "UObject/UObjectIterator.h"
 
 #define LOCTEXT_NAMESPACE "SObjRefDebuggerWindow"
 
 TSharedRef<SWidget> SObjRefDebuggerWindow::BuildMainContent()
 {
+	// 实例列表表头：每一列都可以点击排序
+	TSharedRef<SHeaderRow> InstanceHeaderRow = SNew(SHeaderRow);
+	auto AddInstanceColumn = [this, &InstanceHeaderRow](EObjRefInstanceColumn Column, const FText& Label, float FillWidth)
+	{
+		const FName ColumnId = FObjRefInstanceView::GetColumnId(Column);
+		InstanceHeaderRow->AddColumn(SHeaderRow::Column(ColumnId)
+			.DefaultLabel(Label)
+			.FillWidth(FillWidth)
+			.SortMode(this, &SObjRefDebuggerWindow::GetInstanceColumnSortMode, ColumnId)
+			.OnSort(this, &SObjRefDebuggerWindow::OnInstanceColumnSort));
+	};
+	AddInstanceColumn(EObjRefInstanceColumn::Name, LOCTEXT("InstanceNameColumn", "名称"), 0.3f);
+	AddInstanceColumn(EObjRefInstanceColumn::Class, LOCTEXT("InstanceClassColumn", "类"), 0.2f);
+	AddInstanceColumn(EObjRefInstanceColumn::World, LOCTEXT("InstanceWorldColumn", "世界"), 0.15f);
+	AddInstanceColumn(EObjRefInstanceColumn::MemorySize, LOCTEXT("InstanceMemorySizeColumn", "内存"), 0.12f);
+	AddInstanceColumn(EObjRefInstanceColumn::ReferenceCount, LOCTEXT("InstanceReferenceCountColumn", "引用者"), 0.1f);
+	AddInstanceColumn(EObjRefInstanceColumn::RetainedSize, LOCTEXT("InstanceRetainedSizeColumn", "保留大小"), 0.13f);
+
 	return SNew(SSplitter)
 		.Orientation(Orient_Horizontal)
 
@@ -33,22 +62,84 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildMainContent()
 				.AutoHeight()
 				.Padding(0, 0, 0, 5)
 				[
-					SNew(STextBlock)
-					.Text_Lambda([this]() 
-					{
-						return FText::FromString(FString::Printf(TEXT("类实例列表 (%d)"), ObjectInstances.Num()));
-					})
-					.Font(FEditorStyle::GetFontStyle("DetailsView.CategoryFontStyle"))
+					SNew(SHorizontalBox)
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this]() 
+						{
+							return InstanceView->GetFilterText().IsEmpty() ?
+								FText::FromString(FString::Printf(TEXT("类实例列表 (%d)"), ObjectInstances.Num())) :
+								FText::FromString(FString::Printf(TEXT("类实例列表 (%d / %d)"), ObjectInstances.Num(), InstanceTable->Num()));
+						})
+						.Font(FEditorStyle::GetFontStyle("DetailsView.CategoryFontStyle"))
+					]
+				]
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0, 0, 0, 5)
+				[
+					SNew(SSearchBox)
+					.HintText(LOCTEXT("InstanceFilterHint", "按对象名、路径、类名或世界过滤，^ 开头为前缀匹配..."))
+					.OnTextChanged(this, &SObjRefDebuggerWindow::OnInstanceFilterTextChanged)
 				]
 
 				+ SVerticalBox::Slot()
 				.FillHeight(1.0f)
 				[
-					SAssignNew(ObjectListView, SListView<TSharedPtr<FObjectListItem>>)
+					SAssignNew(ObjectListView, SListView<TWeakObjectPtr<UObject>>)
 					.ListItemsSource(&ObjectInstances)
 					.OnGenerateRow(this, &SObjRefDebuggerWindow::OnGenerateObjectRow)
 					.OnSelectionChanged(this, &SObjRefDebuggerWindow::OnObjectSelectionChanged)
 					.SelectionMode(ESelectionMode::Single)
+					.HeaderRow(InstanceHeaderRow)
+				]
+
+				// 刷新差异：新增的实例在列表中高亮，移除的实例列在下方
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0, 5, 0, 0)
+				[
+					SNew(STextBlock)
+					.Visibility_Lambda([this]() { return bHasResultDiff ? EVisibility::Visible : EVisibility::Collapsed; })
+					.Text_Lambda([this]()
+					{
+						return FText::FromString(FString::Printf(TEXT("与上次结果相比：新增 %d，移除 %d，未变化 %d"),
+							AddedInstances.Num(), RemovedInstances.Num(), NumUnchangedInstances));
+					})
+					.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SExpandableArea)
+					.Visibility_Lambda([this]() { return RemovedInstances.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed; })
+					.InitiallyCollapsed(true)
+					.HeaderContent()
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this]()
+						{
+							return FText::FromString(FString::Printf(TEXT("已移除的实例 (%d)"), RemovedInstances.Num()));
+						})
+						.ColorAndOpacity(FDebuggerTheme::Get().RemovedRowColor)
+					]
+					.BodyContent()
+					[
+						SNew(SBox)
+						.MaxDesiredHeight(200.0f)
+						[
+							SAssignNew(RemovedInstanceListView, SListView<TSharedPtr<FRemovedInstanceInfo>>)
+							.ListItemsSource(&RemovedInstances)
+							.OnGenerateRow(this, &SObjRefDebuggerWindow::OnGenerateRemovedInstanceRow)
+							.SelectionMode(ESelectionMode::None)
+						]
+					]
 				]
 			]
 		]
@@ -112,6 +203,7 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildMainContent()
 					.TreeItemsSource(&ReferenceChainRoots)
 					.OnGenerateRow(this, &SObjRefDebuggerWindow::OnGenerateReferenceChainRow)
 					.OnGetChildren(this, &SObjRefDebuggerWindow::OnGetReferenceChainChildren)
+					.OnExpansionChanged(this, &SObjRefDebuggerWindow::OnReferenceChainExpansionChanged)
 					.OnSelectionChanged(this, &SObjRefDebuggerWindow::OnReferenceChainSelectionChanged)
 					.SelectionMode(ESelectionMode::Single)
 				]
@@ -189,6 +281,15 @@ FReply SObjRefDebuggerWindow::OnForceGCClicked()
 
 FReply SObjRefDebuggerWindow::OnClearResultsClicked()
 {
+	// 正在进行的搜索和引用分析一并取消，否则结果会继续写入已清空的列表
+	CancelSearch();
+	AnalysisJobs.Cancel();
+
+	InstanceTable = MakeShareable(new FObjRefInstanceTable(TArray<FName>()));
+	RowTextCache->Reset();
+	InstanceView->SetTable(InstanceTable);
+	DisplayedResultsKey.Empty();
+	UpdateResultDiff(nullptr);
 	ObjectInstances.Empty();
 	ReferencerInfos.Empty();
 	ReferenceChainRoots.Empty();
@@ -196,8 +297,11 @@ FReply SObjRefDebuggerWindow::OnClearResultsClicked()
 	
 	// 清除所有缓存
 	CachedSearchResults.Empty();
-	CachedReferencers.Empty();
-	CachedReferenceChains.Empty();
+	AnalysisCache->Reset();
+	ReferenceGraph->Invalidate();
+	DominatorTree->Reset();
+	MemorySizeCache->Reset();
+	CondensedGraph->Reset();
 	
 	ObjectListView->RequestListRefresh();
 	ReferencerListView->RequestListRefresh();
@@ -273,6 +377,52 @@ FReply SObjRefDebuggerWindow::OnExportResultsClicked()
 	return FReply::Handled();
 }
 
+FReply SObjRefDebuggerWindow::OnCaptureSnapshotClicked()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!DesktopPlatform)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> SaveFilenames;
+	const bool bSaved = DesktopPlatform->SaveFileDialog(
+		nullptr,
+		LOCTEXT("CaptureSnapshotTitle", "保存堆快照").ToString(),
+		FEditorDirectories::Get().GetLastDirectory(ELastDirectory::GENERIC_EXPORT),
+		FPaths::GetCleanFilename(FObjRefSnapshotWriter::MakeDefaultPath()),
+		FString::Printf(TEXT("Heap Snapshot (*.%s)|*.%s"), FObjRefSnapshotWriter::GetFileExtension(), FObjRefSnapshotWriter::GetFileExtension()),
+		EFileDialogFlags::None,
+		SaveFilenames
+	);
+
+	if (!bSaved || SaveFilenames.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	const FString FilePath = SaveFilenames[0];
+	FEditorDirectories::Get().SetLastDirectory(ELastDirectory::GENERIC_EXPORT, FPaths::GetPath(FilePath));
+
+	// 与窗口共用同一份引用图，增量更新后即可写出，不再单独扫描一次堆
+	FObjRefSnapshotHeader Header;
+	FString Error;
+	const bool bCaptured = FObjRefSnapshotWriter::Capture(*ReferenceGraph, FilePath, Header, Error);
+
+	// 写完后按读取端的方式映射一次，确认文件可以直接打开
+	FObjRefSnapshotView View;
+	const bool bVerified = bCaptured && View.Open(FilePath, Error);
+
+	FNotificationInfo Info(bVerified ?
+		FText::FromString(FString::Printf(TEXT("快照已保存: %u 个对象, %llu 条引用边, %.1f MB\n%s"),
+			Header.NumRecords, Header.NumEdges, Header.FileSize / (1024.0 * 1024.0), *FilePath)) :
+		FText::FromString(FString::Printf(TEXT("快照捕获失败: %s"), *Error)));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	return FReply::Handled();
+}
+
 void SObjRefDebuggerWindow::OnSearchHistorySelectionChanged(TSharedPtr<FSearchHistoryItem> SelectedItem, ESelectInfo::Type SelectInfo)
 {
 	if (SelectedItem.IsValid() && SelectInfo == ESelectInfo::OnMouseClick)
@@ -287,18 +437,8 @@ void SObjRefDebuggerWindow::OnSearchHistorySelectionChanged(TSharedPtr<FSearchHi
 			SelectedClassListView->RequestListRefresh();
 		}
 		
-		// 在类选择器中查找对应的类
-		UClass* TargetClass = nullptr;
-		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-		{
-			UClass* Class = *ClassIt;
-			if (Class->GetName() == SelectedItem->ClassName)
-			{
-				TargetClass = Class;
-				break;
-			}
-		}
-		
+		// 在类选择器中选中对应的类
+		UClass* TargetClass = ClassIndex->FindClass(SelectedItem->ClassName);
 		if (TargetClass && ClassPicker.IsValid())
 		{
 			ClassPicker->SetSelectedClass(TargetClass);
@@ -339,54 +479,86 @@ FText SObjRefDebuggerWindow::GetCurrentViewModeText() const
 	return LOCTEXT("DefaultViewMode", "列表视图");
 }
 
+void SObjRefDebuggerWindow::OnScopeModeSelectionChanged(TSharedPtr<FText> SelectedItem, ESelectInfo::Type SelectInfo)
+{
+	const int32 ScopeIndex = ScopeModeOptions.Find(SelectedItem);
+	if (ScopeIndex != INDEX_NONE)
+	{
+		CurrentFilterOptions.ScopeMode = static_cast<EObjRefScopeMode>(ScopeIndex);
+	}
+}
+
+FText SObjRefDebuggerWindow::GetCurrentScopeModeText() const
+{
+	const int32 ScopeIndex = static_cast<int32>(CurrentFilterOptions.ScopeMode);
+	if (ScopeModeOptions.IsValidIndex(ScopeIndex))
+	{
+		return *ScopeModeOptions[ScopeIndex];
+	}
+	return LOCTEXT("DefaultScopeMode", "整个堆");
+}
+
 // === 统计功能 ===
 
 void SObjRefDebuggerWindow::CalculateStatistics()
 {
 	CurrentStatistics.Reset();
 	
-	CurrentStatistics.TotalInstancesFound = ObjectInstances.Num();
+	CurrentStatistics.TotalInstancesFound = InstanceTable->Num();
 	CurrentStatistics.SearchDuration = LastSearchTime;
 
-	// 计算总内存使用
-	for (const auto& Item : ObjectInstances)
+	// 各项统计都是对结果表单列的线性扫描，分布先按名称ID计数，最后才换成名称
+	for (int64 MemorySize : InstanceTable->GetMemorySizes())
 	{
-		if (Item.IsValid())
-		{
-			CurrentStatistics.TotalMemoryUsage += Item->MemorySize;
-			
-			// 统计引用者数量
-			CurrentStatistics.TotalReferencersFound += Item->ReferenceCount;
-			
-			// 统计GC根对象
-			if (Item->bIsGCRoot)
-			{
-				CurrentStatistics.GCRootObjects++;
-			}
+		CurrentStatistics.TotalMemoryUsage += MemorySize;
+	}
+
+	TArray<int32> InstancesPerClass;
+	InstancesPerClass.SetNumZeroed(InstanceTable->GetClassNames().Num());
+	for (int32 ClassId : InstanceTable->GetClassIds())
+	{
+		++InstancesPerClass[ClassId];
+	}
+
+	TArray<int32> InstancesPerWorld;
+	InstancesPerWorld.SetNumZeroed(InstanceTable->GetWorldNames().Num());
+	for (int32 WorldId : InstanceTable->GetWorldIds())
+	{
+		++InstancesPerWorld[WorldId];
+	}
 
-			// 统计类分布
-			CurrentStatistics.ClassDistribution.FindOrAdd(Item->ClassName)++;
-			
-			// 统计世界分布
-			CurrentStatistics.WorldDistribution.FindOrAdd(Item->WorldName)++;
+	// 引用者数量与GC根来自引用图快照，引用图尚未构建时不统计
+	if (InstanceTable->HasReferenceCounts())
+	{
+		for (int32 ReferenceCount : InstanceTable->GetReferenceCounts())
+		{
+			CurrentStatistics.TotalReferencersFound += ReferenceCount;
+			CurrentStatistics.ObjectsWithoutReferencers += ReferenceCount == 0 ? 1 : 0;
+		}
+		for (EObjRefRowFlags RowFlags : InstanceTable->GetFlags())
+		{
+			CurrentStatistics.GCRootObjects += EnumHasAnyFlags(RowFlags, EObjRefRowFlags::GCRoot) ? 1 : 0;
 		}
 	}
 
-	// 计算最大引用深度
-	for (const auto& RefInfo : ReferencerInfos)
+	for (int32 ClassId = 0; ClassId < InstancesPerClass.Num(); ++ClassId)
 	{
-		if (RefInfo.IsValid())
+		CurrentStatistics.ClassDistribution.FindOrAdd(InstanceTable->GetClassNames()[ClassId]) += InstancesPerClass[ClassId];
+	}
+	for (int32 WorldId = 0; WorldId < InstancesPerWorld.Num(); ++WorldId)
+	{
+		if (InstancesPerWorld[WorldId] > 0)
 		{
-			CurrentStatistics.MaxReferenceDepth = FMath::Max(CurrentStatistics.MaxReferenceDepth, RefInfo->ReferenceDepth);
+			CurrentStatistics.WorldDistribution.FindOrAdd(InstanceTable->GetWorldNames()[WorldId]) += InstancesPerWorld[WorldId];
 		}
 	}
 
-	// 统计无引用者的对象
-	for (const auto& Item : ObjectInstances)
+	// 计算最大引用深度
+	for (const auto& RefInfo : ReferencerInfos)
 	{
-		if (Item.IsValid() && Item->ReferenceCount == 0)
+		if (RefInfo.IsValid())
 		{
-			CurrentStatistics.ObjectsWithoutReferencers++;
+			CurrentStatistics.MaxReferenceDepth = FMath::Max(CurrentStatistics.MaxReferenceDepth, RefInfo->ReferenceDepth);
 		}
 	}
 
@@ -482,22 +654,28 @@ void SObjRefDebuggerWindow::ExportToCSV(const FString& FilePath)
 	FString CSVContent;
 	
 	// CSV 标题行
-	CSVContent += TEXT("对象名称,类名,世界,内存大小(字节),引用者数量,是否GC根\n");
+	CSVContent += TEXT("对象名称,类名,世界,内存大小(字节),独占内存(字节),保留大小(字节),引用者数量,是否GC根\n");
 	
-	// 数据行
-	for (const auto& Item : ObjectInstances)
+	// 数据行，按列表当前的顺序导出
+	for (const TWeakObjectPtr<UObject>& Handle : ObjectInstances)
 	{
-		if (Item.IsValid())
+		UObject* Object = Handle.Get();
+		const int32 Row = InstanceTable->FindRow(Object);
+		if (Row == INDEX_NONE)
 		{
-			CSVContent += FString::Printf(TEXT("%s,%s,%s,%d,%d,%s\n"),
-				*Item->ObjectName.Replace(TEXT(","), TEXT(";")),  // 替换逗号避免CSV格式问题
-				*Item->ClassName,
-				*Item->WorldName.Replace(TEXT(","), TEXT(";")),
-				Item->MemorySize,
-				Item->ReferenceCount,
-				Item->bIsGCRoot ? TEXT("是") : TEXT("否")
-			);
+			continue;
 		}
+
+		CSVContent += FString::Printf(TEXT("%s,%s,%s,%d,%lld,%lld,%d,%s\n"),
+			*Object->GetName().Replace(TEXT(","), TEXT(";")),  // 替换逗号避免CSV格式问题
+			*InstanceTable->GetClassName(Row),
+			*InstanceTable->GetWorldName(Row).Replace(TEXT(","), TEXT(";")),
+			InstanceTable->GetClassStructureSize(Row),
+			InstanceTable->HasExclusiveSizes() ? InstanceTable->GetMemorySizes()[Row] : INDEX_NONE,
+			InstanceTable->GetRetainedSizes()[Row],
+			InstanceTable->GetReferenceCounts()[Row],
+			EnumHasAnyFlags(InstanceTable->GetFlags()[Row], EObjRefRowFlags::GCRoot) ? TEXT("是") : TEXT("否")
+		);
 	}
 	
 	// 添加统计信息
@@ -538,16 +716,19 @@ void SObjRefDebuggerWindow::ExportToJSON(const FString& FilePath)
 	JSONContent += TEXT("  \"instances\": [\n");
 	for (int32 i = 0; i < ObjectInstances.Num(); ++i)
 	{
-		const auto& Item = ObjectInstances[i];
-		if (Item.IsValid())
+		UObject* Object = ObjectInstances[i].Get();
+		const int32 Row = InstanceTable->FindRow(Object);
+		if (Row != INDEX_NONE)
 		{
 			JSONContent += TEXT("    {\n");
-			JSONContent += FString::Printf(TEXT("      \"name\": \"%s\",\n"), *Item->ObjectName.Replace(TEXT("\""), TEXT("\\\"")));
-			JSONContent += FString::Printf(TEXT("      \"class\": \"%s\",\n"), *Item->ClassName);
-			JSONContent += FString::Printf(TEXT("      \"world\": \"%s\",\n"), *Item->WorldName);
-			JSONContent += FString::Printf(TEXT("      \"memorySize\": %d,\n"), Item->MemorySize);
-			JSONContent += FString::Printf(TEXT("      \"referenceCount\": %d,\n"), Item->ReferenceCount);
-			JSONContent += FString::Printf(TEXT("      \"isGCRoot\": %s\n"), Item->bIsGCRoot ? TEXT("true") : TEXT("false"));
+			JSONContent += FString::Printf(TEXT("      \"name\": \"%s\",\n"), *Object->GetName().Replace(TEXT("\""), TEXT("\\\"")));
+			JSONContent += FString::Printf(TEXT("      \"class\": \"%s\",\n"), *InstanceTable->GetClassName(Row));
+			JSONContent += FString::Printf(TEXT("      \"world\": \"%s\",\n"), *InstanceTable->GetWorldName(Row));
+			JSONContent += FString::Printf(TEXT("      \"memorySize\": %d,\n"), InstanceTable->GetClassStructureSize(Row));
+			JSONContent += FString::Printf(TEXT("      \"exclusiveSize\": %lld,\n"), InstanceTable->HasExclusiveSizes() ? InstanceTable->GetMemorySizes()[Row] : INDEX_NONE);
+			JSONContent += FString::Printf(TEXT("      \"retainedSize\": %lld,\n"), InstanceTable->GetRetainedSizes()[Row]);
+			JSONContent += FString::Printf(TEXT("      \"referenceCount\": %d,\n"), InstanceTable->GetReferenceCounts()[Row]);
+			JSONContent += FString::Printf(TEXT("      \"isGCRoot\": %s\n"), EnumHasAnyFlags(InstanceTable->GetFlags()[Row], EObjRefRowFlags::GCRoot) ? TEXT("true") : TEXT("false"));
 			JSONContent += TEXT("    }");
 			if (i < ObjectInstances.Num() - 1) JSONContent += TEXT(",");
 			JSONContent += TEXT("\n");
@@ -1,10 +1,23 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SObjRefDebuggerWindow.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "ObjRefDebuggerDominatorTree.h"
+#include "ObjRefDebuggerMemorySizeCache.h"
+#include "ObjRefDebuggerCondensedGraph.h"
+#include "ObjRefDebuggerClassIndex.h"
+#include "ObjRefDebuggerAnalysisCache.h"
+#include "ObjRefDebuggerInstanceSearch.h"
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerInstanceView.h"
+#include "ObjRefDebuggerQuery.h"
 #include "UObject/UObjectIterator.h"
 #include "Engine/World.h"
 #include "Editor.h"
 #include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/Package.h"
 #include "Engine/Engine.h"
 #include "EngineUtils.h"
 #include "Async/AsyncWork.h"
@@ -17,214 +30,143 @@
 
 #define LOCTEXT_NAMESPACE "SObjRefDebuggerWindow"
 
-// 异步搜索任务类
-class FAsyncObjectSearchTask : public FNonAbandonableTask
+/** 把搜索结果整理为结果表，已被回收的对象直接跳过 */
+static TSharedRef<FObjRefInstanceTable> MakeInstanceTable(const TArray<FObjRefSearchMatch>& Matches, const FObjRefSearchRequest& Request)
 {
-public:
-	FAsyncObjectSearchTask(const FString& InClassName, const FSearchFilterOptions& InFilterOptions)
-		: ClassName(InClassName)
-		, FilterOptions(InFilterOptions)
-	{}
-
-	void DoWork()
+	TArray<FName> TargetClassNames;
+	for (const TWeakObjectPtr<UClass>& TargetClass : Request.TargetClasses)
 	{
-		FindInstancesOfClassInternal(ClassName, FilterOptions, Results);
+		TargetClassNames.Add(TargetClass.IsValid() ? TargetClass->GetFName() : NAME_None);
 	}
 
-	FORCEINLINE TStatId GetStatId() const { RETURN_QUICK_DECLARE_CYCLE_STAT(FAsyncObjectSearchTask, STATGROUP_ThreadPoolAsyncTasks); }
-
-	TArray<TSharedPtr<FObjectListItem>> GetResults() const { return Results; }
+	TSharedRef<FObjRefInstanceTable> Table = MakeShared<FObjRefInstanceTable>(TargetClassNames);
+	Table->Append(Matches);
+	return Table;
+}
 
-private:
-	FString ClassName;
-	FSearchFilterOptions FilterOptions;
-	TArray<TSharedPtr<FObjectListItem>> Results;
+/** 按类名查找类，查询中允许带 C++ 前缀（UMaterialInstanceDynamic、AActor） */
+static UClass* FindQueryClass(FObjRefClassIndex& ClassIndex, const FString& ClassName)
+{
+	UClass* Class = ClassIndex.FindClass(ClassName);
+	if (!Class && ClassName.Len() > 1 && (ClassName[0] == TEXT('U') || ClassName[0] == TEXT('A')) && FChar::IsUpper(ClassName[1]))
+	{
+		Class = ClassIndex.FindClass(ClassName.RightChop(1));
+	}
+	return Class;
+}
 
-	void FindInstancesOfClassInternal(const FString& InClassName, const FSearchFilterOptions& InFilterOptions, TArray<TSharedPtr<FObjectListItem>>& OutInstances)
+bool SObjRefDebuggerWindow::BuildSearchRequest(const TArray<FString>& ClassNames, FObjRefSearchRequest& OutRequest)
+{
+	// 查询只编译一次，之后每个候选对象只执行谓词链
+	FString QueryError;
+	if (!FObjRefQuery::Compile(CurrentQueryText, CurrentFilterOptions, OutRequest.Query, QueryError))
 	{
-		// 首先查找指定的类
-		UClass* TargetClass = nullptr;
-		
-		// 遍历所有UClass查找匹配的类名
-		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-		{
-			UClass* CurrentClass = *ClassIt;
-			if (CurrentClass->GetName() == InClassName)
-			{
-				TargetClass = CurrentClass;
-				break;
-			}
-		}
-		
-		if (!TargetClass)
-		{
-			return;
-		}
+		UE_LOG(LogTemp, Warning, TEXT("查询语法错误: %s"), *QueryError);
 
-		// 获取相关世界对象
-		TArray<UWorld*> WorldsToSearch;
-		if (GEditor)
-		{
-			for (const FWorldContext& Context : GEditor->GetWorldContexts())
-			{
-				if ((Context.WorldType == EWorldType::Editor && InFilterOptions.bIncludeEditorWorld) ||
-					(Context.WorldType == EWorldType::PIE && InFilterOptions.bIncludePIEWorld) ||
-					(Context.WorldType == EWorldType::Game && InFilterOptions.bIncludeGameWorld))
-				{
-					if (Context.World())
-					{
-						WorldsToSearch.Add(Context.World());
-					}
-				}
-			}
-		}
+		FNotificationInfo Info(FText::Format(LOCTEXT("QuerySyntaxError", "查询语法错误: {0}"), FText::FromString(QueryError)));
+		Info.ExpireDuration = 4.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return false;
+	}
+	const FObjRefQuery& Query = OutRequest.Query;
 
-		// 检查是否是AActor的子类
-		if (TargetClass->IsChildOf(AActor::StaticClass()))
+	// 通过类名索引解析所有目标类（已选择的类加上查询中的 class: 条件），重复的类只保留一个
+	TArray<FString> TargetClassNames = ClassNames;
+	TargetClassNames.Append(Query.GetClassNames());
+	for (const FString& ClassName : TargetClassNames)
+	{
+		UClass* TargetClass = FindQueryClass(*ClassIndex, ClassName);
+		if (!TargetClass)
 		{
-			// 使用TActorIterator进行更安全的Actor查找
-			for (UWorld* World : WorldsToSearch)
-			{
-				for (TActorIterator<AActor> ActorIt(World, TargetClass); ActorIt; ++ActorIt)
-				{
-					AActor* CurrentActor = *ActorIt;
-					if (ShouldIncludeObjectStatic(CurrentActor, InFilterOptions))
-					{
-						OutInstances.Add(MakeShareable(new FObjectListItem(CurrentActor)));
-					}
-				}
-			}
+			UE_LOG(LogTemp, Warning, TEXT("找不到类: %s"), *ClassName);
+			continue;
 		}
-		else
+		OutRequest.TargetClasses.AddUnique(TargetClass);
+	}
+	for (const FString& ClassName : Query.GetExcludedClassNames())
+	{
+		if (UClass* ExcludedClass = FindQueryClass(*ClassIndex, ClassName))
 		{
-			// 使用通用的TObjectIterator
-			for (TObjectIterator<UObject> It; It; ++It)
-			{
-				UObject* CurrentObject = *It;
-				if (CurrentObject->IsA(TargetClass))
-				{
-					if (ShouldIncludeObjectStatic(CurrentObject, InFilterOptions))
-					{
-						OutInstances.Add(MakeShareable(new FObjectListItem(CurrentObject)));
-					}
-				}
-			}
+			OutRequest.ExcludedClasses.AddUnique(ExcludedClass);
 		}
 	}
 
-	static bool ShouldIncludeObjectStatic(UObject* Object, const FSearchFilterOptions& FilterOptions)
+	// 只有查询条件、没有任何目标类时，在所有对象中按条件查找
+	if (TargetClassNames.Num() == 0 && !Query.IsEmpty())
 	{
-		if (!IsValid(Object))
-		{
-			return false;
-		}
+		OutRequest.TargetClasses.Add(UObject::StaticClass());
+	}
 
-		// 过滤类默认对象 (CDO)
-		if (Object->HasAnyFlags(RF_ClassDefaultObject))
+	// 精确的 outer: 或 package: 作为候选来源；对象不存在时不可能有任何匹配
+	if (Query.GetSource() != EObjRefQuerySource::ClassHash)
+	{
+		UObject* Scope = Query.GetSource() == EObjRefQuerySource::Package ?
+			static_cast<UObject*>(FindPackage(nullptr, *Query.GetSourcePath())) :
+			StaticFindObject(UObject::StaticClass(), nullptr, *Query.GetSourcePath());
+		if (!Scope)
 		{
-			return false;
-		}
+			UE_LOG(LogTemp, Warning, TEXT("找不到查询范围: %s"), *Query.GetSourcePath());
 
-		// 过滤待销毁的对象
-		if (Object->IsPendingKill())
-		{
+			FNotificationInfo Info(FText::Format(LOCTEXT("ScopeNotFound", "找不到搜索范围: {0}（对象或包未加载）"), FText::FromString(Query.GetSourcePath())));
+			Info.ExpireDuration = 4.0f;
+			FSlateNotificationManager::Get().AddNotification(Info);
 			return false;
 		}
+		OutRequest.CandidateScope = Scope;
 
-		// 过滤原型对象
-		if (Object->HasAnyFlags(RF_ArchetypeObject))
-		{
-			return false;
-		}
+		// 范围条件改为按解析出的对象比较，包路径与子对象路径的写法不再影响匹配
+		OutRequest.Query.BindSourceObject(Scope);
+	}
 
-		// 世界过滤
-		UWorld* ObjectWorld = Object->GetWorld();
-		if (ObjectWorld)
+	// 获取相关世界对象，Actor 类只在这些世界中查找
+	if (GEditor)
+	{
+		for (const FWorldContext& Context : GEditor->GetWorldContexts())
 		{
-			EWorldType::Type WorldType = ObjectWorld->WorldType;
-			if ((WorldType == EWorldType::Editor && !FilterOptions.bIncludeEditorWorld) ||
-				(WorldType == EWorldType::PIE && !FilterOptions.bIncludePIEWorld) ||
-				(WorldType == EWorldType::Game && !FilterOptions.bIncludeGameWorld))
+			if (Context.World() && Query.AcceptsWorldType(Context.WorldType))
 			{
-				return false;
+				OutRequest.Worlds.Add(Context.World());
 			}
 		}
-
-		return true;
 	}
-};
 
-void SObjRefDebuggerWindow::FindInstancesOfClass(const FString& ClassName, TArray<TSharedPtr<FObjectListItem>>& OutInstances)
+	// 过滤选项按值复制，后台线程不再读取窗口成员
+	OutRequest.FilterOptions = CurrentFilterOptions;
+
+	return OutRequest.TargetClasses.Num() > 0;
+}
+
+bool SObjRefDebuggerWindow::HasSearchCriteria() const
 {
-	// 首先查找指定的类
-	UClass* TargetClass = nullptr;
-	
-	// 遍历所有UClass查找匹配的类名
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	return CurrentClassNames.Num() > 0 || !CurrentQueryText.IsEmpty()
+		|| (CurrentFilterOptions.ScopeMode != EObjRefScopeMode::Global && !CurrentFilterOptions.ScopePath.IsEmpty());
+}
+
+FString SObjRefDebuggerWindow::MakeSearchCacheKey(const TArray<FString>& ClassNames) const
+{
+	FString CacheKey = FString::Join(ClassNames, TEXT(","));
+	if (!CurrentQueryText.IsEmpty())
 	{
-		UClass* CurrentClass = *ClassIt;
-		if (CurrentClass->GetName() == ClassName)
-		{
-			TargetClass = CurrentClass;
-			break;
-		}
+		CacheKey += TEXT("|") + CurrentQueryText;
 	}
-	
-	if (!TargetClass)
+	if (CurrentFilterOptions.ScopeMode != EObjRefScopeMode::Global && !CurrentFilterOptions.ScopePath.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("找不到类: %s"), *ClassName);
-		return;
+		CacheKey += FString::Printf(TEXT("|scope%d:%s"), static_cast<int32>(CurrentFilterOptions.ScopeMode), *CurrentFilterOptions.ScopePath);
 	}
+	return CacheKey;
+}
 
-	// 获取相关世界对象
-	TArray<UWorld*> WorldsToSearch;
-	if (GEditor)
+void SObjRefDebuggerWindow::FindInstancesOfClass(const FString& ClassName, TArray<TWeakObjectPtr<UObject>>& OutInstances)
+{
+	FObjRefSearchRequest Request;
+	if (!BuildSearchRequest({ ClassName }, Request))
 	{
-		for (const FWorldContext& Context : GEditor->GetWorldContexts())
-		{
-			if ((Context.WorldType == EWorldType::Editor && CurrentFilterOptions.bIncludeEditorWorld) ||
-				(Context.WorldType == EWorldType::PIE && CurrentFilterOptions.bIncludePIEWorld) ||
-				(Context.WorldType == EWorldType::Game && CurrentFilterOptions.bIncludeGameWorld))
-			{
-				if (Context.World())
-				{
-					WorldsToSearch.Add(Context.World());
-				}
-			}
-		}
+		return;
 	}
 
-	// 检查是否是AActor的子类
-	if (TargetClass->IsChildOf(AActor::StaticClass()))
-	{
-		// 使用TActorIterator进行更安全的Actor查找
-		for (UWorld* World : WorldsToSearch)
-		{
-			for (TActorIterator<AActor> ActorIt(World, TargetClass); ActorIt; ++ActorIt)
-			{
-				AActor* CurrentActor = *ActorIt;
-				if (ShouldIncludeObject(CurrentActor, CurrentFilterOptions))
-				{
-					OutInstances.Add(MakeShareable(new FObjectListItem(CurrentActor)));
-				}
-			}
-		}
-	}
-	else
-	{
-		// 使用通用的TObjectIterator
-		for (TObjectIterator<UObject> It; It; ++It)
-		{
-			UObject* CurrentObject = *It;
-			if (CurrentObject->IsA(TargetClass))
-			{
-				if (ShouldIncludeObject(CurrentObject, CurrentFilterOptions))
-				{
-					OutInstances.Add(MakeShareable(new FObjectListItem(CurrentObject)));
-				}
-			}
-		}
-	}
+	TArray<FObjRefSearchMatch> Matches;
+	FObjRefInstanceSearch::Run(Request, Matches);
+	MakeInstanceTable(Matches, Request)->AppendHandles(OutInstances);
 
 	UE_LOG(LogTemp, Log, TEXT("找到 %d 个 %s 类的实例"), OutInstances.Num(), *ClassName);
 }
@@ -236,58 +178,32 @@ void SObjRefDebuggerWindow::FindObjectReferencers(UObject* TargetObject, TArray<
 		return;
 	}
 
-	FReferencerInformationList ReferencerList;
-	
-	// 使用IsReferenced API查找引用者
-	IsReferenced(TargetObject, RF_NoFlags, EInternalObjectFlags::AllFlags, true, &ReferencerList);
+	// 使用反向引用图查找引用者，每个GC周期只需扫描一次堆
+	ReferenceGraph->EnsureUpToDate();
+
+	TArray<FObjRefGraphEdge> Edges;
+	ReferenceGraph->GetReferencers(TargetObject, Edges);
 
 	OutReferencers.Empty();
 	
-	// 处理外部引用
-	for (const FReferencerInformation& RefInfo : ReferencerList.ExternalReferences)
+	// 同一个引用者可能通过多个属性引用目标，只保留第一个属性
+	TSet<int32> SeenReferencers;
+	for (const FObjRefGraphEdge& Edge : Edges)
 	{
-		if (UObject* Referencer = RefInfo.Referencer)
+		UObject* Referencer = FObjRefReferenceGraph::GetObjectByIndex(Edge.ReferencerIndex);
+		if (!Referencer || SeenReferencers.Contains(Edge.ReferencerIndex))
 		{
-			FString PropName = TEXT("未知属性");
-			
-			// 获取引用属性信息
-			if (RefInfo.ReferencingProperties.Num() > 0)
-			{
-				// 简化处理，取第一个属性
-				const FProperty* Property = RefInfo.ReferencingProperties[0];
-				PropName = Property->GetName();
-			}
-
-			FString ReferencerName = Referencer->GetName();
-			FString ReferencerClass = Referencer->GetClass()->GetName();
-			
-			// 如果是世界中的对象，添加世界信息
-			if (UWorld* ReferencerWorld = Referencer->GetWorld())
-			{
-				ReferencerName += FString::Printf(TEXT(" (%s)"), *ReferencerWorld->GetName());
-			}
-
-			OutReferencers.Add(MakeShareable(new FReferencerInfo(
-				ReferencerName, 
-				ReferencerClass, 
-				PropName, 
-				Referencer,
-				0  // 初始深度为0
-			)));
+			continue;
 		}
-	}
-	
-	// 处理内部引用
-	for (const FReferencerInformation& RefInfo : ReferencerList.InternalReferences)
-	{
-		if (UObject* Referencer = RefInfo.Referencer)
+		SeenReferencers.Add(Edge.ReferencerIndex);
+
+		// 处理内部引用（引用者位于目标对象的Outer链内）
+		if (Referencer->IsIn(TargetObject))
 		{
 			FString PropName = TEXT("内部引用");
-			
-			if (RefInfo.ReferencingProperties.Num() > 0)
+			if (!Edge.PropertyName.IsNone())
 			{
-				const FProperty* Property = RefInfo.ReferencingProperties[0];
-				PropName = FString::Printf(TEXT("内部: %s"), *Property->GetName());
+				PropName = FString::Printf(TEXT("内部: %s"), *Edge.PropertyName.ToString());
 			}
 
 			OutReferencers.Add(MakeShareable(new FReferencerInfo(
@@ -297,7 +213,27 @@ void SObjRefDebuggerWindow::FindObjectReferencers(UObject* TargetObject, TArray<
 				Referencer,
 				0  // 内部引用深度为0
 			)));
+			continue;
+		}
+
+		// 处理外部引用
+		FString PropName = Edge.PropertyName.IsNone() ? TEXT("未知属性") : Edge.PropertyName.ToString();
+		FString ReferencerName = Referencer->GetName();
+		FString ReferencerClass = Referencer->GetClass()->GetName();
+		
+		// 如果是世界中的对象，添加世界信息
+		if (UWorld* ReferencerWorld = Referencer->GetWorld())
+		{
+			ReferencerName += FString::Printf(TEXT(" (%s)"), *ReferencerWorld->GetName());
 		}
+
+		OutReferencers.Add(MakeShareable(new FReferencerInfo(
+			ReferencerName, 
+			ReferencerClass, 
+			PropName, 
+			Referencer,
+			0  // 初始深度为0
+		)));
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("为对象 %s 找到 %d 个引用者"), *TargetObject->GetName(), OutReferencers.Num());
@@ -311,19 +247,26 @@ void SObjRefDebuggerWindow::BuildReferenceChainToRoot(UObject* TargetObject, TAr
 	}
 
 	OutRootNodes.Empty();
-	TSet<UObject*> VisitedObjects;
 
-	// 创建目标对象的根节点
+	// 整条引用链共用同一份引用图快照
+	ReferenceGraph->EnsureUpToDate();
+
+	if (CurrentFilterOptions.ReferenceChainMode == EReferenceChainMode::ShortestPath)
+	{
+		BuildShortestReferenceChains(TargetObject, OutRootNodes);
+		return;
+	}
+
+	// 创建目标对象的根节点，只生成第一层引用者，其余在展开时按需生成
 	TSharedPtr<FReferenceChainNode> TargetNode = MakeShareable(new FReferenceChainNode(TargetObject, 0));
-	
-	// 递归构建引用链
-	BuildReferenceChainRecursive(TargetNode, VisitedObjects, CurrentFilterOptions.MaxReferenceDepth);
+	ExpandReferenceChainNode(TargetNode);
 
 	// 添加到根节点列表
 	OutRootNodes.Add(TargetNode);
 
 	// 如果没有引用者，创建一个虚拟的GC根节点
-	if (TargetNode->Children.Num() == 0)
+	if (CondensedGraph->GetReferencingComponents(TargetNode->ComponentId).Num() == 0
+		&& CondensedGraph->GetRootKind(TargetNode->ComponentId) == EObjRefRootKind::None)
 	{
 		TSharedPtr<FReferenceChainNode> GCRootNode = MakeShareable(new FReferenceChainNode(nullptr, 0));
 		GCRootNode->ObjectName = TEXT("无引用者 - 可被GC回收");
@@ -337,104 +280,287 @@ void SObjRefDebuggerWindow::BuildReferenceChainToRoot(UObject* TargetObject, TAr
 	}
 }
 
-void SObjRefDebuggerWindow::BuildReferenceChainRecursive(TSharedPtr<FReferenceChainNode> CurrentNode, TSet<UObject*>& VisitedObjects, int32 MaxDepth)
+/** GC根类型的显示文本 */
+static const TCHAR* GetRootKindText(EObjRefRootKind RootKind)
 {
-	if (!CurrentNode.IsValid() || !IsValid(CurrentNode->Object) || CurrentNode->Depth >= MaxDepth)
+	switch (RootKind)
 	{
-		return;
+	case EObjRefRootKind::RootSet:
+		return TEXT("根集");
+	case EObjRefRootKind::DisregardForGC:
+		return TEXT("常驻对象");
+	case EObjRefRootKind::KeepFlags:
+		return TEXT("Standalone");
+	default:
+		return TEXT("未知");
 	}
+}
+
+void SObjRefDebuggerWindow::BuildShortestReferenceChains(UObject* TargetObject, TArray<TSharedPtr<FReferenceChainNode>>& OutRootNodes)
+{
+	TArray<TArray<FObjRefPathStep>> Paths;
+	ReferenceGraph->FindShortestPathsToRoot(GUObjectArray.ObjectToIndex(TargetObject), CurrentFilterOptions.MaxShortestPaths, Paths);
+	BuildShortestReferenceChainNodes(TargetObject, Paths, OutRootNodes);
+}
+
+void SObjRefDebuggerWindow::StartShortestChainAnalysis(UObject* TargetObject, const FObjRefJobToken& Token)
+{
+	// 引用图只在游戏线程上更新，工作线程只做只读的广度优先搜索
+	ReferenceGraph->EnsureUpToDate();
+
+	TSharedPtr<FReferenceChainNode> PendingNode = MakeShareable(new FReferenceChainNode(nullptr, 0));
+	PendingNode->ObjectName = TEXT("正在查找引用链...");
+	PendingNode->ClassName = TEXT("分析中");
+	PendingNode->bIsGCRoot = false;
+	ReferenceChainRoots.Add(PendingNode);
+
+	// 清理已经结束的任务
+	AnalysisTasks.RemoveAll([](const TFuture<void>& Task) { return Task.IsReady(); });
+
+	const FObjRefReferenceGraph* Graph = ReferenceGraph.Get();
+	const int32 TargetIndex = GUObjectArray.ObjectToIndex(TargetObject);
+	const int32 MaxPaths = CurrentFilterOptions.MaxShortestPaths;
+	const FObjRefAnalysisStamp Stamp = FObjRefAnalysisStamp::FromGraph(*ReferenceGraph);
+	TWeakPtr<SObjRefDebuggerWindow> WeakWindow = SharedThis(this);
+	TWeakObjectPtr<UObject> WeakTarget = TargetObject;
+
+	// 窗口销毁前会取消并等待这些任务，任务内可以直接使用引用图指针
+	AnalysisTasks.Add(Async(EAsyncExecution::ThreadPool, [Graph, TargetIndex, MaxPaths, Stamp, Token, WeakWindow, WeakTarget]()
+	{
+		TSharedRef<TArray<TArray<FObjRefPathStep>>, ESPMode::ThreadSafe> Paths = MakeShared<TArray<TArray<FObjRefPathStep>>, ESPMode::ThreadSafe>();
+		Graph->FindShortestPathsToRoot(TargetIndex, MaxPaths, *Paths, Token);
+		if (Token.IsCancelled())
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Paths, Stamp, Token, WeakWindow, WeakTarget]()
+		{
+			TSharedPtr<SObjRefDebuggerWindow> Window = WeakWindow.Pin();
+			UObject* Target = WeakTarget.Get();
+			if (Token.IsCancelled() || !Window.IsValid() || !Target)
+			{
+				return;
+			}
+			Window->OnShortestChainAnalysisComplete(Target, *Paths, Stamp);
+		});
+	}));
+}
 
-	// 防止循环引用
-	if (VisitedObjects.Contains(CurrentNode->Object))
+void SObjRefDebuggerWindow::OnShortestChainAnalysisComplete(UObject* TargetObject, const TArray<TArray<FObjRefPathStep>>& Paths, const FObjRefAnalysisStamp& Stamp)
+{
+	ReferenceChainRoots.Empty();
+	BuildShortestReferenceChainNodes(TargetObject, Paths, ReferenceChainRoots);
+	// 查找期间发生过GC或引用图已更新时结果不会写入缓存
+	AnalysisCache->AddReferenceChains(TargetObject, Stamp, ReferenceChainRoots);
+	ReferenceChainTreeView->RequestTreeRefresh();
+}
+
+void SObjRefDebuggerWindow::BuildShortestReferenceChainNodes(UObject* TargetObject, const TArray<TArray<FObjRefPathStep>>& Paths, TArray<TSharedPtr<FReferenceChainNode>>& OutRootNodes)
+{
+	const int32 TargetIndex = GUObjectArray.ObjectToIndex(TargetObject);
+	TSharedPtr<FReferenceChainNode> TargetNode = MakeShareable(new FReferenceChainNode(TargetObject, 0));
+
+	if (Paths.Num() == 0)
 	{
+		// 从任何GC根都无法到达，下次GC就会被回收
+		TSharedPtr<FReferenceChainNode> GCRootNode = MakeShareable(new FReferenceChainNode(nullptr, 0));
+		GCRootNode->ObjectName = TEXT("无GC根路径 - 可被GC回收");
+		GCRootNode->ClassName = TEXT("GC状态");
+		GCRootNode->Children.Add(TargetNode);
+		TargetNode->Parent = GCRootNode;
+		TargetNode->Depth = 1;
+		OutRootNodes.Add(GCRootNode);
 		return;
 	}
-	VisitedObjects.Add(CurrentNode->Object);
 
-	// 查找当前对象的引用者
-	FReferencerInformationList ReferencerList;
-	IsReferenced(CurrentNode->Object, RF_NoFlags, EInternalObjectFlags::AllFlags, true, &ReferencerList);
+	OutRootNodes.Add(TargetNode);
+
+	// 最大深度只影响显示：超出部分折叠成一个省略节点，路径末端的GC根始终保留
+	const int32 MaxDisplayDepth = CurrentFilterOptions.MaxReferenceDepth > 0 ? CurrentFilterOptions.MaxReferenceDepth : MAX_int32;
+
+	// BFS 结果是一棵以目标为根的树，同一个对象只会出现一次，按对象索引合并公共前缀
+	TMap<int32, TSharedPtr<FReferenceChainNode>> NodesByIndex;
+	NodesByIndex.Add(TargetIndex, TargetNode);
 
-	// 处理外部引用
-	for (const FReferencerInformation& RefInfo : ReferencerList.ExternalReferences)
+	for (const TArray<FObjRefPathStep>& Path : Paths)
 	{
-		if (UObject* Referencer = RefInfo.Referencer)
+		const int32 LastStep = Path.Num() - 1;
+		TSharedPtr<FReferenceChainNode> ParentNode = TargetNode;
+
+		for (int32 StepIndex = 1; StepIndex <= LastStep; ++StepIndex)
 		{
-			// 跳过已访问的对象
-			if (VisitedObjects.Contains(Referencer))
+			if (StepIndex >= MaxDisplayDepth && StepIndex < LastStep)
 			{
+				TSharedPtr<FReferenceChainNode> ElidedNode = MakeShareable(new FReferenceChainNode(nullptr, ParentNode->Depth + 1));
+				ElidedNode->ObjectName = FString::Printf(TEXT("... 省略 %d 层 ..."), LastStep - StepIndex);
+				ElidedNode->ClassName = TEXT("省略");
+				ElidedNode->bIsGCRoot = false;
+				ElidedNode->Parent = ParentNode;
+				ParentNode->Children.Add(ElidedNode);
+				ParentNode = ElidedNode;
+				StepIndex = LastStep - 1;
 				continue;
 			}
 
-			TSharedPtr<FReferenceChainNode> ReferencerNode = MakeShareable(new FReferenceChainNode(Referencer, CurrentNode->Depth + 1));
-			ReferencerNode->Parent = CurrentNode;
-			
-			// 设置引用属性名
-			if (RefInfo.ReferencingProperties.Num() > 0)
+			const FObjRefPathStep& Step = Path[StepIndex];
+			TSharedPtr<FReferenceChainNode>& Node = NodesByIndex.FindOrAdd(Step.ObjectIndex);
+			if (!Node.IsValid())
 			{
-				const FProperty* Property = RefInfo.ReferencingProperties[0];
-				ReferencerNode->PropertyName = Property->GetName();
+				Node = MakeShareable(new FReferenceChainNode(FObjRefReferenceGraph::GetObjectByIndex(Step.ObjectIndex), ParentNode->Depth + 1));
+				Node->bIsGCRoot = false;
+				const FName PropertyName = ReferenceGraph->GetPropertyName(Step.PropertyId);
+				if (!PropertyName.IsNone())
+				{
+					Node->PropertyName = PropertyName.ToString();
+				}
+				Node->Parent = ParentNode;
+				ParentNode->Children.Add(Node);
 			}
+			ParentNode = Node;
+		}
+
+		// 路径末端是GC根，追加一个说明根类型的叶子节点
+		const EObjRefRootKind RootKind = ReferenceGraph->GetRootKind(Path[LastStep].ObjectIndex);
+		TSharedPtr<FReferenceChainNode> GCRootNode = MakeShareable(new FReferenceChainNode(nullptr, ParentNode->Depth + 1));
+		GCRootNode->ObjectName = FString::Printf(TEXT("GC根 (%s)"), GetRootKindText(RootKind));
+		GCRootNode->ClassName = TEXT("Root");
+		GCRootNode->Parent = ParentNode;
+		ParentNode->Children.Add(GCRootNode);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("为对象 %s 找到 %d 条到GC根的最短路径，长度 %d"),
+		*TargetObject->GetName(), Paths.Num(), Paths[0].Num() - 1);
+}
 
-			CurrentNode->Children.Add(ReferencerNode);
+void SObjRefDebuggerWindow::AddClusterMemberNodes(TSharedPtr<FReferenceChainNode> ClusterNode)
+{
+	// 成员很多的簇只列出前面一部分，避免一次生成上万个行
+	static const int32 MaxClusterMembersShown = 200;
+
+	TArrayView<const int32> Members = CondensedGraph->GetMembers(ClusterNode->ComponentId);
 
-			// 递归构建更深层的引用链
-			BuildReferenceChainRecursive(ReferencerNode, VisitedObjects, MaxDepth);
+	TSharedPtr<FReferenceChainNode> MembersNode = MakeShareable(new FReferenceChainNode(nullptr, ClusterNode->Depth + 1));
+	MembersNode->ObjectName = FString::Printf(TEXT("簇成员 (%d)"), Members.Num());
+	MembersNode->ClassName = TEXT("循环引用");
+	MembersNode->bIsGCRoot = false;
+	MembersNode->Parent = ClusterNode;
+	ClusterNode->Children.Add(MembersNode);
+
+	for (int32 MemberIndex = 0; MemberIndex < Members.Num() && MemberIndex < MaxClusterMembersShown; ++MemberIndex)
+	{
+		UObject* Member = FObjRefReferenceGraph::GetObjectByIndex(Members[MemberIndex]);
+		if (!Member || Member == ClusterNode->Object)
+		{
+			continue;
 		}
+
+		TSharedPtr<FReferenceChainNode> MemberNode = MakeShareable(new FReferenceChainNode(Member, ClusterNode->Depth + 2));
+		MemberNode->ComponentId = ClusterNode->ComponentId;
+		MemberNode->Parent = MembersNode;
+		MembersNode->Children.Add(MemberNode);
 	}
 
-	// 如果没有外部引用者，这可能是一个GC根
-	if (CurrentNode->Children.Num() == 0 && CurrentNode->Depth > 0)
+	if (Members.Num() > MaxClusterMembersShown)
 	{
-		TSharedPtr<FReferenceChainNode> GCRootNode = MakeShareable(new FReferenceChainNode(nullptr, CurrentNode->Depth + 1));
-		GCRootNode->ObjectName = TEXT("GC根");
-		GCRootNode->ClassName = TEXT("Root");
-		GCRootNode->Parent = CurrentNode;
-		CurrentNode->Children.Add(GCRootNode);
+		TSharedPtr<FReferenceChainNode> MoreNode = MakeShareable(new FReferenceChainNode(nullptr, ClusterNode->Depth + 2));
+		MoreNode->ObjectName = FString::Printf(TEXT("... 其余 %d 个成员 ..."), Members.Num() - MaxClusterMembersShown);
+		MoreNode->ClassName = TEXT("已折叠");
+		MoreNode->bIsGCRoot = false;
+		MoreNode->Parent = MembersNode;
+		MembersNode->Children.Add(MoreNode);
 	}
-
-	VisitedObjects.Remove(CurrentNode->Object);
 }
 
-bool SObjRefDebuggerWindow::ShouldIncludeObject(UObject* Object, const FSearchFilterOptions& FilterOptions) const
+void SObjRefDebuggerWindow::ExpandReferenceChainNode(TSharedPtr<FReferenceChainNode> CurrentNode)
 {
-	if (!IsValid(Object))
+	if (!CurrentNode.IsValid())
 	{
-		return false;
+		return;
 	}
 
-	// 过滤类默认对象 (CDO)
-	if (Object->HasAnyFlags(RF_ClassDefaultObject))
+	CurrentNode->Children.Reset();
+	CurrentNode->bChildrenPending = false;
+
+	if (!IsValid(CurrentNode->Object))
 	{
-		return false;
+		return;
 	}
 
-	// 过滤待销毁的对象
-	if (Object->IsPendingKill())
+	// 穷举模式在强连通分量缩合图上展开，循环引用只显示为一个簇节点
+	// 缩合图在一个GC周期内保留，不随增量更新重算；只有展开到计算之后才出现的对象时，
+	// 才应用增量变化并重算一次。节点生成后缩合图可能已经重算，分量ID按对象重新解析
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(CurrentNode->Object);
+	if (!CondensedGraph->IsUpToDate(*ReferenceGraph)
+		|| (CondensedGraph->GetComponent(ObjectIndex) == INDEX_NONE && !CondensedGraph->IsLatestVersion(*ReferenceGraph)))
 	{
-		return false;
+		ReferenceGraph->EnsureUpToDate();
+		CondensedGraph->Compute(*ReferenceGraph);
+	}
+	CurrentNode->ComponentId = CondensedGraph->GetComponent(ObjectIndex);
+	CurrentNode->ClusterSize = FMath::Max(CondensedGraph->GetComponentSize(CurrentNode->ComponentId), 1);
+	if (CurrentNode->ComponentId == INDEX_NONE)
+	{
+		return;
 	}
 
-	// 过滤原型对象
-	if (Object->HasAnyFlags(RF_ArchetypeObject))
+	// 循环引用簇先列出成员，簇内部的引用不再展开
+	if (CurrentNode->ClusterSize > 1)
 	{
-		return false;
+		AddClusterMemberNodes(CurrentNode);
 	}
 
-	// 世界过滤
-	UWorld* ObjectWorld = Object->GetWorld();
-	if (ObjectWorld)
+	const EObjRefRootKind RootKind = CondensedGraph->GetRootKind(CurrentNode->ComponentId);
+	if (RootKind != EObjRefRootKind::None)
 	{
-		EWorldType::Type WorldType = ObjectWorld->WorldType;
-		if ((WorldType == EWorldType::Editor && !FilterOptions.bIncludeEditorWorld) ||
-			(WorldType == EWorldType::PIE && !FilterOptions.bIncludePIEWorld) ||
-			(WorldType == EWorldType::Game && !FilterOptions.bIncludeGameWorld))
+		TSharedPtr<FReferenceChainNode> GCRootNode = MakeShareable(new FReferenceChainNode(nullptr, CurrentNode->Depth + 1));
+		GCRootNode->ObjectName = FString::Printf(TEXT("GC根 (%s)"), GetRootKindText(RootKind));
+		GCRootNode->ClassName = TEXT("Root");
+		GCRootNode->Parent = CurrentNode;
+		CurrentNode->Children.Add(GCRootNode);
+	}
+
+	// 缩合图是有向无环图，沿引用分量向上展开不会回到自身，无需访问集合
+	for (const FObjRefCondensedEdge& Edge : CondensedGraph->GetReferencingComponents(CurrentNode->ComponentId))
+	{
+		UObject* Referencer = FObjRefReferenceGraph::GetObjectByIndex(Edge.SourceIndex);
+		if (!Referencer || Referencer->IsIn(CurrentNode->Object))
 		{
-			return false;
+			continue;
 		}
-	}
 
-	return true;
+		TSharedPtr<FReferenceChainNode> ReferencerNode = MakeShareable(new FReferenceChainNode(Referencer, CurrentNode->Depth + 1));
+		ReferencerNode->Parent = CurrentNode;
+		ReferencerNode->ComponentId = Edge.SourceComponent;
+		ReferencerNode->ClusterSize = CondensedGraph->GetComponentSize(Edge.SourceComponent);
+		if (ReferencerNode->ClusterSize > 1)
+		{
+			ReferencerNode->ObjectName = FString::Printf(TEXT("循环簇: %s (%d 个对象)"), *Referencer->GetName(), ReferencerNode->ClusterSize);
+		}
+		
+		// 设置引用属性名
+		const FName PropertyName = ReferenceGraph->GetPropertyName(Edge.PropertyId);
+		if (!PropertyName.IsNone())
+		{
+			ReferencerNode->PropertyName = PropertyName.ToString();
+		}
+
+		CurrentNode->Children.Add(ReferencerNode);
+
+		// 还有更深的内容时放一个占位节点，让树显示展开箭头
+		if (ReferencerNode->ClusterSize > 1
+			|| CondensedGraph->GetRootKind(Edge.SourceComponent) != EObjRefRootKind::None
+			|| CondensedGraph->GetReferencingComponents(Edge.SourceComponent).Num() > 0)
+		{
+			TSharedPtr<FReferenceChainNode> PlaceholderNode = MakeShareable(new FReferenceChainNode(nullptr, ReferencerNode->Depth + 1));
+			PlaceholderNode->ObjectName = TEXT("展开以加载引用者...");
+			PlaceholderNode->ClassName = TEXT("未加载");
+			PlaceholderNode->bIsGCRoot = false;
+			PlaceholderNode->Parent = ReferencerNode;
+			ReferencerNode->Children.Add(PlaceholderNode);
+			ReferencerNode->bChildrenPending = true;
+		}
+	}
 }
 
 UWorld* SObjRefDebuggerWindow::GetWorldByType(EWorldType::Type WorldType) const
@@ -454,153 +580,401 @@ UWorld* SObjRefDebuggerWindow::GetWorldByType(EWorldType::Type WorldType) const
 
 void SObjRefDebuggerWindow::StartAsyncSearch(const FString& ClassName)
 {
+	StartAsyncMultiClassSearch({ ClassName });
+}
+
+void SObjRefDebuggerWindow::StartAsyncMultiClassSearch(const TArray<FString>& ClassNames)
+{
+	UE_LOG(LogTemp, Log, TEXT("StartAsyncMultiClassSearch 开始，要搜索 %d 个类"), ClassNames.Num());
+	
+	// 类解析和世界收集需要在游戏线程完成，搜索本身交给后台线程
+	TSharedRef<FObjRefSearchRequest, ESPMode::ThreadSafe> Request = MakeShared<FObjRefSearchRequest, ESPMode::ThreadSafe>();
+	if (!BuildSearchRequest(ClassNames, *Request))
+	{
+		return;
+	}
+
+	// 新搜索取代正在进行的搜索，旧搜索在下一个分块开始前退出，结果不再写回
+	CancelSearch();
+	const FObjRefJobToken Token = SearchJobs.BeginJob();
+
 	bIsSearching = true;
 	LastSearchTime = FPlatformTime::Seconds();
 
-	// 使用简化的异步执行
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ClassName]()
+	const FString CacheKey = MakeSearchCacheKey(ClassNames);
+
+	if (Request->FilterOptions.bTimeSlicedSearch)
 	{
-		// 在后台线程执行搜索
-		TArray<TSharedPtr<FObjectListItem>> Results;
-		FAsyncObjectSearchTask SearchTask(ClassName, CurrentFilterOptions);
-		SearchTask.DoWork();
-		Results = SearchTask.GetResults();
+		StartTimeSlicedSearch(*Request, CacheKey);
+		return;
+	}
+
+	TWeakPtr<SObjRefDebuggerWindow> WeakWindow = SharedThis(this);
+
+	// 后台线程持有GC锁并用 ParallelFor 在所有工作线程上过滤，窗口只以弱引用访问
+	Async(EAsyncExecution::ThreadPool, [Request, Token, WeakWindow, CacheKey]()
+	{
+		TSharedRef<TArray<FObjRefSearchMatch>, ESPMode::ThreadSafe> Matches = MakeShared<TArray<FObjRefSearchMatch>, ESPMode::ThreadSafe>();
+		if (!FObjRefInstanceSearch::Run(*Request, *Matches, Token))
+		{
+			return;
+		}
 
 		// 回到游戏线程更新UI
-		AsyncTask(ENamedThreads::GameThread, [this, ClassName, Results]()
+		AsyncTask(ENamedThreads::GameThread, [Request, Matches, Token, WeakWindow, CacheKey]()
 		{
-			OnAsyncSearchComplete(Results);
-			
+			TSharedPtr<SObjRefDebuggerWindow> Window = WeakWindow.Pin();
+			if (Token.IsCancelled() || !Window.IsValid())
+			{
+				return;
+			}
+
+			TSharedRef<FObjRefInstanceTable> AllResults = MakeInstanceTable(*Matches, *Request);
+
+			UE_LOG(LogTemp, Log, TEXT("搜索完成，总共找到 %d 个实例，结果表 %.1f KB，缓存键: %s"),
+				AllResults->Num(), AllResults->GetAllocatedSize() / 1024.0, *CacheKey);
+
+			Window->OnAsyncSearchComplete(AllResults, Request->Query, CacheKey);
+
 			// 更新缓存
-			CachedSearchResults.Add(ClassName, Results);
-			bIsSearching = false;
+			Window->CachedSearchResults.Add(CacheKey, AllResults);
+			Window->bIsSearching = false;
 		});
 	});
 }
 
-void SObjRefDebuggerWindow::StartAsyncMultiClassSearch(const TArray<FString>& ClassNames)
+void SObjRefDebuggerWindow::CancelSearch()
 {
-	UE_LOG(LogTemp, Log, TEXT("StartAsyncMultiClassSearch 开始，要搜索 %d 个类"), ClassNames.Num());
-	
-	bIsSearching = true;
-	LastSearchTime = FPlatformTime::Seconds();
+	SearchJobs.Cancel();
+	StopTimeSlicedSearch();
+	bIsSearching = false;
+}
 
-	// 在主线程执行搜索（因为UE的迭代器不是线程安全的）
-	TArray<TSharedPtr<FObjectListItem>> AllResults;
-	
-	for (const FString& ClassName : ClassNames)
+void SObjRefDebuggerWindow::UpdateExclusiveSizes(FObjRefInstanceTable& Table)
+{
+	if (Table.Num() == 0)
 	{
-		UE_LOG(LogTemp, Log, TEXT("开始搜索类: %s"), *ClassName);
-		
-		// 首先查找指定的类
-		UClass* TargetClass = nullptr;
-		
-		// 遍历所有UClass查找匹配的类名
-		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-		{
-			UClass* CurrentClass = *ClassIt;
-			if (CurrentClass->GetName() == ClassName)
-			{
-				TargetClass = CurrentClass;
-				UE_LOG(LogTemp, Log, TEXT("找到目标类: %s"), *ClassName);
-				break;
-			}
-		}
-		
-		if (!TargetClass)
+		return;
+	}
+
+	TArray<UObject*> Objects;
+	Objects.Reserve(Table.Num());
+	for (int32 Row = 0; Row < Table.Num(); ++Row)
+	{
+		Objects.Add(Table.ResolveRow(Row));
+	}
+
+	TArray<int64> Sizes;
+	MemorySizeCache->GetExclusiveSizes(Objects, Sizes);
+	Table.SetExclusiveSizes(Sizes);
+}
+
+void SObjRefDebuggerWindow::UpdateRetainedSizes(FObjRefInstanceTable& Table)
+{
+	if (Table.Num() == 0)
+	{
+		return;
+	}
+
+	ReferenceGraph->EnsureUpToDate();
+	if (!DominatorTree->IsUpToDate(*ReferenceGraph))
+	{
+		DominatorTree->Compute(*ReferenceGraph, [](UObject* Object) -> int64
 		{
-			UE_LOG(LogTemp, Warning, TEXT("找不到类: %s"), *ClassName);
-			continue;
-		}
+			return Object->GetClass()->GetStructureSize();
+		});
+	}
+
+	// 对象索引列直接作为支配树的下标，无需再解析对象
+	const TArray<int32>& ObjectIndices = Table.GetObjectIndices();
+	TArray<int64>& RetainedSizes = Table.GetRetainedSizes();
+	for (int32 Row = 0; Row < Table.Num(); ++Row)
+	{
+		RetainedSizes[Row] = DominatorTree->GetRetainedSize(ObjectIndices[Row]);
+	}
+}
+
+void SObjRefDebuggerWindow::UpdateReferenceCounts(FObjRefInstanceTable& Table)
+{
+	// 引用图尚未构建时不为统计单独触发一次全堆扫描
+	if (ReferenceGraph->GetNumObjects() == 0 || Table.Num() == 0)
+	{
+		return;
+	}
+	Table.UpdateReferenceColumns(*ReferenceGraph);
+}
+
+void SObjRefDebuggerWindow::FinalizeSearchResults(FObjRefInstanceTable& Table, const FObjRefQuery& Query)
+{
+	// 查询用到的列即使在过滤选项中关闭也要统计，否则结果表阶段的谓词无从求值
+	if (CurrentFilterOptions.bComputeResourceSize || Query.UsesField(EObjRefQueryField::Size))
+	{
+		UpdateExclusiveSizes(Table);
+	}
+	if (CurrentFilterOptions.bComputeRetainedSize || Query.UsesField(EObjRefQueryField::Retained))
+	{
+		UpdateRetainedSizes(Table);
+	}
+	if (Query.NeedsReferenceGraph())
+	{
+		ReferenceGraph->EnsureUpToDate();
+	}
+	UpdateReferenceCounts(Table);
+
+	if (Query.HasRowPredicates())
+	{
+		const int32 NumRemoved = Table.RemoveRowsIf([&Table, &Query](int32 Row) { return !Query.MatchesRow(Table, Row); });
+		UE_LOG(LogTemp, Log, TEXT("查询条件在结果表上排除了 %d 行，剩余 %d 行"), NumRemoved, Table.Num());
+	}
+}
+
+void SObjRefDebuggerWindow::StartTimeSlicedSearch(const FObjRefSearchRequest& Request, const FString& CacheKey)
+{
+	StopTimeSlicedSearch();
+
+	TimeSlicedSearch = MakeShareable(new FObjRefTimeSlicedSearch(Request));
+	TimeSlicedSearchCacheKey = CacheKey;
+
+	// 同一条件的上一次结果保留到搜索完成，用来计算差异；逐帧显示的部分结果不作为比较的基准
+	if (CacheKey == DisplayedResultsKey)
+	{
+		TimeSlicedPreviousTable = InstanceTable;
+	}
+	else
+	{
+		RowTextCache->Reset();
+	}
+	DisplayedResultsKey.Empty();
+
+	// 先清空列表，结果随扫描逐帧出现
+	InstanceTable = MakeInstanceTable(TArray<FObjRefSearchMatch>(), Request);
+	InstanceView->SetTable(InstanceTable);
+	RefreshInstanceList();
+	ReferencerInfos.Empty();
+	ReferenceChainRoots.Empty();
+	ReferencerListView->RequestListRefresh();
+	ReferenceChainTreeView->RequestTreeRefresh();
 
-		// 获取相关世界对象
-		TArray<UWorld*> WorldsToSearch;
-		if (GEditor)
+	TimeSlicedSearchTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &SObjRefDebuggerWindow::TickTimeSlicedSearch));
+	TimeSlicedSearchGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddSP(this, &SObjRefDebuggerWindow::OnTimeSlicedSearchGarbageCollected);
+
+	UE_LOG(LogTemp, Log, TEXT("分帧搜索开始，每帧预算 %.1f 毫秒"), Request.FilterOptions.TimeSliceBudgetMs);
+}
+
+bool SObjRefDebuggerWindow::TickTimeSlicedSearch(float DeltaTime)
+{
+	if (!TimeSlicedSearch.IsValid())
+	{
+		return false;
+	}
+
+	TArray<FObjRefSearchMatch> NewMatches;
+	const double BudgetSeconds = TimeSlicedSearch->GetRequest().FilterOptions.TimeSliceBudgetMs / 1000.0;
+	const bool bIsComplete = TimeSlicedSearch->Step(BudgetSeconds, NewMatches);
+
+	if (NewMatches.Num() > 0)
+	{
+		// 新行只经过过滤追加到列表末尾，排序在搜索完成后恢复
+		const int32 FirstNewRow = InstanceTable->Num();
+		InstanceTable->Append(NewMatches);
+		const int32 FirstVisibleRow = InstanceView->AppendRows(FirstNewRow);
+		const TArray<int32>& VisibleRows = InstanceView->GetVisibleRows();
+		InstanceTable->AppendHandles(ObjectInstances, MakeArrayView(VisibleRows).Slice(FirstVisibleRow, VisibleRows.Num() - FirstVisibleRow));
+		ObjectListView->RequestListRefresh();
+	}
+
+	if (bIsComplete)
+	{
+		FinishTimeSlicedSearch();
+		return false;
+	}
+	return true;
+}
+
+void SObjRefDebuggerWindow::OnTimeSlicedSearchGarbageCollected()
+{
+	if (!TimeSlicedSearch.IsValid())
+	{
+		return;
+	}
+
+	TimeSlicedSearch->OnGarbageCollected();
+
+	// 去掉已被回收的行；引用者信息持有对象裸指针，一并清空
+	InstanceTable->RemoveStaleRows();
+	InstanceView->Refresh();
+	RefreshInstanceList();
+	ReferencerInfos.Empty();
+	ReferenceChainRoots.Empty();
+	ReferencerListView->RequestListRefresh();
+	ReferenceChainTreeView->RequestTreeRefresh();
+}
+
+void SObjRefDebuggerWindow::FinishTimeSlicedSearch()
+{
+	const FString CacheKey = TimeSlicedSearchCacheKey;
+	const FObjRefQuery Query = TimeSlicedSearch->GetRequest().Query;
+	const TSharedPtr<FObjRefInstanceTable> PreviousTable = TimeSlicedPreviousTable;
+	StopTimeSlicedSearch();
+
+	// 结果已逐帧显示，这里只补充内存信息并应用结果表阶段的查询条件，不清空用户在搜索期间选中的引用信息
+	FinalizeSearchResults(*InstanceTable, Query);
+	UpdateResultDiff(PreviousTable.Get());
+	DisplayedResultsKey = CacheKey;
+	InstanceView->Refresh();
+	RefreshInstanceList();
+
+	const float SearchDuration = FPlatformTime::Seconds() - LastSearchTime;
+	CalculateStatistics();
+	CurrentStatistics.SearchDuration = SearchDuration;
+	UpdateStatisticsDisplay();
+
+	CachedSearchResults.Add(CacheKey, InstanceTable);
+	bIsSearching = false;
+
+	UE_LOG(LogTemp, Log, TEXT("分帧搜索完成，用时 %.3f 秒，找到 %d 个实例"), SearchDuration, ObjectInstances.Num());
+}
+
+void SObjRefDebuggerWindow::StopTimeSlicedSearch()
+{
+	if (TimeSlicedSearchTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TimeSlicedSearchTickerHandle);
+		TimeSlicedSearchTickerHandle.Reset();
+	}
+	if (TimeSlicedSearchGCHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(TimeSlicedSearchGCHandle);
+		TimeSlicedSearchGCHandle.Reset();
+	}
+	TimeSlicedSearch.Reset();
+	TimeSlicedSearchCacheKey.Empty();
+	TimeSlicedPreviousTable.Reset();
+}
+
+TOptional<float> SObjRefDebuggerWindow::GetSearchProgress() const
+{
+	if (TimeSlicedSearch.IsValid())
+	{
+		return TimeSlicedSearch->GetProgress();
+	}
+	return TOptional<float>();
+}
+
+void SObjRefDebuggerWindow::OnAsyncSearchComplete(TSharedPtr<FObjRefInstanceTable> Results, const FObjRefQuery& Query, const FString& CacheKey)
+{
+	FinalizeSearchResults(*Results, Query);
+
+	// 同一条件的新结果（刷新、GC后重新搜索）与当前显示的结果比较，只有新增和移除的行需要更新
+	const TSharedPtr<FObjRefInstanceTable> PreviousTable = CacheKey == DisplayedResultsKey ? InstanceTable : nullptr;
+	InstanceTable = Results;
+	DisplayedResultsKey = CacheKey;
+	if (!PreviousTable.IsValid())
+	{
+		RowTextCache->Reset();
+	}
+	UpdateResultDiff(PreviousTable.Get());
+
+	// 数据源仍是对象弱引用：未变化的对象与旧列表中的项相等，列表控件复用它们已生成的行，只为新增的对象生成新行
+	InstanceView->SetTable(InstanceTable);
+	RefreshInstanceList();
+
+	UObject* SelectedObject = CurrentSelectedObject.Get();
+	if (PreviousTable.IsValid() && SelectedObject && InstanceTable->FindRow(SelectedObject) != INDEX_NONE)
+	{
+		// 选中的对象仍在结果中，保留选择并刷新引用信息；同一GC周期内直接命中分析缓存
+		OnObjectSelectionChanged(CurrentSelectedObject, ESelectInfo::Direct);
+	}
+	else
+	{
+		ReferencerInfos.Empty();
+		ReferenceChainRoots.Empty();
+		ReferencerListView->RequestListRefresh();
+		ReferenceChainTreeView->RequestTreeRefresh();
+	}
+
+	float SearchDuration = FPlatformTime::Seconds() - LastSearchTime;
+
+	CalculateStatistics();
+	CurrentStatistics.SearchDuration = SearchDuration;
+	UpdateStatisticsDisplay();
+
+	UE_LOG(LogTemp, Log, TEXT("异步搜索完成，用时 %.3f 秒，找到 %d 个实例"), SearchDuration, Results->Num());
+}
+
+void SObjRefDebuggerWindow::UpdateResultDiff(const FObjRefInstanceTable* PreviousTable)
+{
+	AddedInstances.Reset();
+	RemovedInstances.Reset();
+	NumUnchangedInstances = 0;
+	bHasResultDiff = PreviousTable != nullptr;
+
+	if (PreviousTable)
+	{
+		FObjRefTableDiff Diff;
+		FObjRefInstanceTable::Diff(*PreviousTable, *InstanceTable, Diff);
+		NumUnchangedInstances = Diff.NumUnchanged;
+
+		AddedInstances.Reserve(Diff.AddedRows.Num());
+		for (int32 Row : Diff.AddedRows)
 		{
-			for (const FWorldContext& Context : GEditor->GetWorldContexts())
+			if (UObject* Object = InstanceTable->ResolveRow(Row))
 			{
-				if ((Context.WorldType == EWorldType::Editor && CurrentFilterOptions.bIncludeEditorWorld) ||
-					(Context.WorldType == EWorldType::PIE && CurrentFilterOptions.bIncludePIEWorld) ||
-					(Context.WorldType == EWorldType::Game && CurrentFilterOptions.bIncludeGameWorld))
-				{
-					if (Context.World())
-					{
-						WorldsToSearch.Add(Context.World());
-					}
-				}
+				AddedInstances.Add(FObjectKey(Object));
 			}
 		}
 
-		// 检查是否是AActor的子类
-		if (TargetClass->IsChildOf(AActor::StaticClass()))
+		// 被回收的对象已无法访问，名称取自它最后一次显示时缓存的文本，从未显示过的只能给出对象索引
+		const TArray<int32>& ObjectIndices = PreviousTable->GetObjectIndices();
+		const TArray<int32>& SerialNumbers = PreviousTable->GetSerialNumbers();
+		RemovedInstances.Reserve(Diff.RemovedRows.Num());
+		for (int32 Row : Diff.RemovedRows)
 		{
-			UE_LOG(LogTemp, Log, TEXT("类 %s 是 AActor 子类，使用 Actor 迭代器"), *ClassName);
-			// 使用TActorIterator进行更安全的Actor查找
-			for (UWorld* World : WorldsToSearch)
+			UObject* Object = PreviousTable->ResolveRow(Row);
+			FString ObjectName;
+			if (Object)
 			{
-				UE_LOG(LogTemp, Log, TEXT("在世界 %s 中搜索"), World ? *World->GetName() : TEXT("NULL"));
-				int32 ActorCount = 0;
-				for (TActorIterator<AActor> ActorIt(World, TargetClass); ActorIt; ++ActorIt)
-				{
-					AActor* CurrentActor = *ActorIt;
-					if (ShouldIncludeObject(CurrentActor, CurrentFilterOptions))
-					{
-						AllResults.Add(MakeShareable(new FObjectListItem(CurrentActor)));
-						ActorCount++;
-					}
-				}
-				UE_LOG(LogTemp, Log, TEXT("在世界 %s 中找到 %d 个 %s 实例"), 
-					World ? *World->GetName() : TEXT("NULL"), ActorCount, *ClassName);
+				ObjectName = Object->GetName();
 			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Log, TEXT("类 %s 不是 AActor 子类，使用通用迭代器"), *ClassName);
-			int32 ObjectCount = 0;
-			// 使用通用的TObjectIterator
-			for (TObjectIterator<UObject> It; It; ++It)
+			else if (const FText* CachedName = RowTextCache->FindObjectName(ObjectIndices[Row], SerialNumbers[Row]))
 			{
-				UObject* CurrentObject = *It;
-				if (CurrentObject->IsA(TargetClass))
-				{
-					if (ShouldIncludeObject(CurrentObject, CurrentFilterOptions))
-					{
-						AllResults.Add(MakeShareable(new FObjectListItem(CurrentObject)));
-						ObjectCount++;
-					}
-				}
+				ObjectName = CachedName->ToString();
+			}
+			else
+			{
+				ObjectName = FString::Printf(TEXT("#%d"), ObjectIndices[Row]);
 			}
-			UE_LOG(LogTemp, Log, TEXT("找到 %d 个 %s 实例"), ObjectCount, *ClassName);
+
+			RemovedInstances.Add(MakeShareable(new FRemovedInstanceInfo(ObjectName,
+				PreviousTable->GetClassName(Row), PreviousTable->GetWorldName(Row),
+				PreviousTable->GetMemorySizes()[Row], Object == nullptr)));
 		}
+
+		UE_LOG(LogTemp, Log, TEXT("增量刷新: 新增 %d, 移除 %d, 未变化 %d"),
+			Diff.AddedRows.Num(), Diff.RemovedRows.Num(), Diff.NumUnchanged);
 	}
 
-	// 立即更新UI（因为我们在主线程执行）
-	FString CacheKey = FString::Join(ClassNames, TEXT(","));
-	UE_LOG(LogTemp, Log, TEXT("搜索完成，总共找到 %d 个实例，缓存键: %s"), AllResults.Num(), *CacheKey);
-	
-	OnAsyncSearchComplete(AllResults);
-	
-	// 更新缓存
-	CachedSearchResults.Add(CacheKey, AllResults);
-	UE_LOG(LogTemp, Log, TEXT("结果已缓存，缓存大小: %d"), CachedSearchResults.Num());
-	
-	bIsSearching = false;
-	
-	UE_LOG(LogTemp, Log, TEXT("多类搜索完成，找到 %d 个实例"), AllResults.Num());
+	if (RemovedInstanceListView.IsValid())
+	{
+		RemovedInstanceListView->RequestListRefresh();
+	}
 }
 
-void SObjRefDebuggerWindow::OnAsyncSearchComplete(TArray<TSharedPtr<FObjectListItem>> Results)
+bool SObjRefDebuggerWindow::IsAddedInstance(const TWeakObjectPtr<UObject>& Item) const
 {
-	ObjectInstances = Results;
-	ReferencerInfos.Empty();
-	ReferenceChainRoots.Empty();
-	
-	ObjectListView->RequestListRefresh();
-	ReferencerListView->RequestListRefresh();
-	ReferenceChainTreeView->RequestTreeRefresh();
+	if (AddedInstances.Num() == 0)
+	{
+		return false;
+	}
+	UObject* Object = Item.Get();
+	return Object && AddedInstances.Contains(FObjectKey(Object));
+}
 
-	float SearchDuration = FPlatformTime::Seconds() - LastSearchTime;
-	UE_LOG(LogTemp, Log, TEXT("异步搜索完成，用时 %.3f 秒，找到 %d 个实例"), SearchDuration, Results.Num());
+void SObjRefDebuggerWindow::RefreshInstanceList()
+{
+	ObjectInstances.Reset();
+	InstanceTable->AppendHandles(ObjectInstances, InstanceView->GetVisibleRows());
+	ObjectListView->RequestListRefresh();
 }
 
 // === GC 相关功能实现 ===
@@ -635,7 +1009,7 @@ void SObjRefDebuggerWindow::OnGCComplete()
 	FSlateNotificationManager::Get().AddNotification(Info);
 
 	// 如果当前有搜索结果，则自动刷新
-	if (CurrentClassNames.Num() > 0)
+	if (HasSearchCriteria())
 	{
 		// 清除缓存强制重新搜索
 		TArray<FString> ClassNameStrings;
@@ -646,14 +1020,10 @@ void SObjRefDebuggerWindow::OnGCComplete()
 				ClassNameStrings.Add(*ClassName);
 			}
 		}
-		FString CacheKey = FString::Join(ClassNameStrings, TEXT(","));
-		CachedSearchResults.Remove(CacheKey);
+		CachedSearchResults.Remove(MakeSearchCacheKey(ClassNameStrings));
 		
-		// 执行搜索
-		if (!bIsSearching)
-		{
-			StartAsyncMultiClassSearch(ClassNameStrings);
-		}
+		// 执行搜索，取代GC前仍在进行的搜索
+		StartAsyncMultiClassSearch(ClassNameStrings);
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("强制GC完成，已自动刷新搜索结果"));
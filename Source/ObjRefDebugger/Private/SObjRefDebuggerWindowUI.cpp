@@ -1,6 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SObjRefDebuggerWindow.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+#include "ObjRefDebuggerDominatorTree.h"
+#include "ObjRefDebuggerMemorySizeCache.h"
+#include "ObjRefDebuggerCondensedGraph.h"
+#include "ObjRefDebuggerClassIndex.h"
+#include "ObjRefDebuggerAnalysisCache.h"
+#include "ObjRefDebuggerInstanceTable.h"
+#include "ObjRefDebuggerInstanceView.h"
+#include "ObjRefDebuggerQuery.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SButton.h"
@@ -33,12 +42,30 @@ void SObjRefDebuggerWindow::Construct(const FArguments& InArgs)
 	CurrentViewMode = 0;
 	bShowAdvancedOptions = false;
 	LastRefreshTime = FDateTime::Now();
+	NumUnchangedInstances = 0;
+	bHasResultDiff = false;
+	ReferenceGraph = MakeShareable(new FObjRefReferenceGraph());
+	DominatorTree = MakeShareable(new FObjRefDominatorTree());
+	MemorySizeCache = MakeShareable(new FObjRefMemorySizeCache());
+	CondensedGraph = MakeShareable(new FObjRefCondensedGraph());
+	ClassIndex = MakeShareable(new FObjRefClassIndex());
+	AnalysisCache = MakeShareable(new FObjRefAnalysisCache(static_cast<SIZE_T>(CurrentFilterOptions.AnalysisCacheBudgetMB) * 1024 * 1024));
+	InstanceTable = MakeShareable(new FObjRefInstanceTable(TArray<FName>()));
+	RowTextCache = MakeShareable(new FObjRefRowTextCache());
+	InstanceView = MakeShareable(new FObjRefInstanceView());
+	InstanceView->SetTable(InstanceTable);
 
 	// 初始化视图模式选项
 	ViewModeOptions.Add(MakeShareable(new FText(LOCTEXT("ListViewMode", "列表视图"))));
 	ViewModeOptions.Add(MakeShareable(new FText(LOCTEXT("DetailViewMode", "详细视图"))));
 	ViewModeOptions.Add(MakeShareable(new FText(LOCTEXT("GraphViewMode", "图表视图"))));
 
+	// 初始化搜索范围选项
+	ScopeModeOptions.Add(MakeShareable(new FText(LOCTEXT("GlobalScope", "整个堆"))));
+	ScopeModeOptions.Add(MakeShareable(new FText(LOCTEXT("OuterScope", "Outer 的直接子对象"))));
+	ScopeModeOptions.Add(MakeShareable(new FText(LOCTEXT("OuterTreeScope", "Outer 下的所有对象"))));
+	ScopeModeOptions.Add(MakeShareable(new FText(LOCTEXT("PackageScope", "包内的所有对象"))));
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -85,6 +112,18 @@ void SObjRefDebuggerWindow::Construct(const FArguments& InArgs)
 	];
 }
 
+SObjRefDebuggerWindow::~SObjRefDebuggerWindow()
+{
+	CancelSearch();
+
+	// 分析任务直接读取引用图，取消后等待它们退出再释放引用图
+	AnalysisJobs.Cancel();
+	for (TFuture<void>& Task : AnalysisTasks)
+	{
+		Task.Wait();
+	}
+}
+
 TSharedRef<SWidget> SObjRefDebuggerWindow::BuildTopToolbar()
 {
 	return SNew(SBorder)
@@ -202,6 +241,16 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildTopToolbar()
 					.OnClicked(this, &SObjRefDebuggerWindow::OnExportResultsClicked)
 					.ToolTipText(LOCTEXT("ExportTooltip", "导出搜索结果到文件"))
 				]
+
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(5, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CaptureSnapshot", "捕获快照"))
+					.OnClicked(this, &SObjRefDebuggerWindow::OnCaptureSnapshotClicked)
+					.ToolTipText(LOCTEXT("CaptureSnapshotTooltip", "把堆中所有对象的索引、类、Outer、标志、大小与强引用边写入二进制快照文件，供离线分析"))
+				]
 			]
 		];
 }
@@ -250,8 +299,117 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildSearchArea()
 				[
 					SNew(SButton)
 					.Text(LOCTEXT("SearchButton", "搜索实例"))
+					.ToolTipText(LOCTEXT("SearchButtonTooltip", "搜索进行中再次点击会取消当前搜索并重新开始"))
 					.OnClicked(this, &SObjRefDebuggerWindow::OnSearchClicked)
-					.IsEnabled_Lambda([this]() { return !bIsSearching; })
+				]
+
+				// 取消按钮
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Bottom)
+				.Padding(5.0f, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CancelSearchButton", "取消"))
+					.OnClicked(this, &SObjRefDebuggerWindow::OnCancelSearchClicked)
+					.Visibility_Lambda([this]()
+					{
+						return bIsSearching ? EVisibility::Visible : EVisibility::Collapsed;
+					})
+				]
+			]
+
+			// 搜索范围
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 8, 0, 0)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ScopeLabel", "搜索范围:"))
+					.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(5.0f, 0, 0, 0)
+				[
+					SNew(SComboBox<TSharedPtr<FText>>)
+					.OptionsSource(&ScopeModeOptions)
+					.OnGenerateWidget_Lambda([](TSharedPtr<FText> Item)
+					{
+						return SNew(STextBlock).Text(*Item);
+					})
+					.OnSelectionChanged(this, &SObjRefDebuggerWindow::OnScopeModeSelectionChanged)
+					.Content()
+					[
+						SNew(STextBlock)
+						.Text(this, &SObjRefDebuggerWindow::GetCurrentScopeModeText)
+					]
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				.Padding(5.0f, 0, 0, 0)
+				[
+					SNew(SEditableTextBox)
+					.HintText(LOCTEXT("ScopePathHint", "对象路径或包名，例如 /Game/Maps/Arena"))
+					.ToolTipText(LOCTEXT("ScopePathTooltip", "通过引擎的 Outer 哈希与包哈希只枚举范围内的对象，搜索代价与范围大小成正比"))
+					.IsEnabled_Lambda([this]()
+					{
+						return CurrentFilterOptions.ScopeMode != EObjRefScopeMode::Global;
+					})
+					.OnTextChanged_Lambda([this](const FText& NewText)
+					{
+						CurrentFilterOptions.ScopePath = NewText.ToString().TrimStartAndEnd();
+					})
+					.OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType)
+					{
+						CurrentFilterOptions.ScopePath = NewText.ToString().TrimStartAndEnd();
+						if (CommitType == ETextCommit::OnEnter)
+						{
+							OnSearchClicked();
+						}
+					})
+				]
+			]
+
+			// 查询条件输入框
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 8, 0, 0)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("QueryLabel", "查询条件:"))
+					.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0, 2, 0, 0)
+				[
+					SNew(SEditableTextBox)
+					.HintText(LOCTEXT("QueryHint", "例如 class:UMaterialInstanceDynamic outer:/Game/UI/* world:PIE refs>3 size>1MB flags:!Standalone"))
+					.ToolTipText(FObjRefQuery::GetSyntaxHelp())
+					.OnTextChanged_Lambda([this](const FText& NewText)
+					{
+						CurrentQueryText = NewText.ToString().TrimStartAndEnd();
+					})
+					.OnTextCommitted_Lambda([this](const FText& NewText, ETextCommit::Type CommitType)
+					{
+						CurrentQueryText = NewText.ToString().TrimStartAndEnd();
+						if (CommitType == ETextCommit::OnEnter)
+						{
+							OnSearchClicked();
+						}
+					})
 				]
 			]
 
@@ -298,6 +456,7 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildSearchArea()
 			.Padding(0, 10, 0, 0)
 			[
 				SAssignNew(SearchProgressBar, SProgressBar)
+				.Percent(this, &SObjRefDebuggerWindow::GetSearchProgress)
 				.Visibility_Lambda([this]()
 				{
 					return bIsSearching ? EVisibility::Visible : EVisibility::Collapsed;
@@ -437,6 +596,88 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildFilterOptions()
 					.Text(LOCTEXT("AutoRefresh", "自动刷新"))
 				]
 			]
+
+			+ SGridPanel::Slot(1, 2)
+			.Padding(5)
+			[
+				SNew(SCheckBox)
+				.IsChecked(CurrentFilterOptions.bParallelGraphBuild ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+				{
+					CurrentFilterOptions.bParallelGraphBuild = (NewState == ECheckBoxState::Checked);
+					ReferenceGraph->SetBuildMode(CurrentFilterOptions.bParallelGraphBuild ? EObjRefGraphBuildMode::Parallel : EObjRefGraphBuildMode::SingleThreaded);
+				})
+				.ToolTipText(LOCTEXT("ParallelGraphBuildTooltip", "按对象索引分块，在所有CPU核心上并行收集引用"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ParallelGraphBuild", "并行构建引用图"))
+				]
+			]
+
+			+ SGridPanel::Slot(2, 2)
+			.Padding(5)
+			[
+				SNew(SCheckBox)
+				.IsChecked(CurrentFilterOptions.ReferenceChainMode == EReferenceChainMode::ShortestPath ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+				{
+					CurrentFilterOptions.ReferenceChainMode = (NewState == ECheckBoxState::Checked) ? EReferenceChainMode::ShortestPath : EReferenceChainMode::AllPaths;
+					AnalysisCache->ResetReferenceChains();
+				})
+				.ToolTipText(LOCTEXT("ShortestPathModeTooltip", "只显示从GC根到目标的最短强引用路径；关闭后穷举所有路径（受最大深度限制）"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ShortestPathMode", "最短路径模式"))
+				]
+			]
+
+			+ SGridPanel::Slot(0, 3)
+			.Padding(5)
+			[
+				SNew(SCheckBox)
+				.IsChecked(CurrentFilterOptions.bComputeRetainedSize ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+				{
+					CurrentFilterOptions.bComputeRetainedSize = (NewState == ECheckBoxState::Checked);
+				})
+				.ToolTipText(LOCTEXT("ComputeRetainedSizeTooltip", "搜索完成后在全堆上计算支配树，显示每个实例被回收时能一起释放的内存；每个GC周期计算一次，大型关卡中耗时较长"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ComputeRetainedSize", "计算保留大小"))
+				]
+			]
+
+			+ SGridPanel::Slot(1, 3)
+			.Padding(5)
+			[
+				SNew(SCheckBox)
+				.IsChecked(CurrentFilterOptions.bComputeResourceSize ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+				{
+					CurrentFilterOptions.bComputeResourceSize = (NewState == ECheckBoxState::Checked);
+				})
+				.ToolTipText(LOCTEXT("ComputeResourceSizeTooltip", "统计对象自身、容器分配和资源（纹理、网格等）占用的独占内存，结果按对象缓存"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ComputeResourceSize", "统计资源内存"))
+				]
+			]
+
+			+ SGridPanel::Slot(2, 3)
+			.Padding(5)
+			[
+				SNew(SCheckBox)
+				.IsChecked(CurrentFilterOptions.bTimeSlicedSearch ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+				.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+				{
+					CurrentFilterOptions.bTimeSlicedSearch = (NewState == ECheckBoxState::Checked);
+				})
+				.ToolTipText(LOCTEXT("TimeSlicedSearchTooltip", "在游戏线程上每帧只扫描一小段对象数组，结果逐帧显示，进度条显示扫描进度"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("TimeSlicedSearch", "分帧搜索"))
+				]
+			]
 		];
 }
 
@@ -602,69 +843,187 @@ TSharedRef<SWidget> SObjRefDebuggerWindow::BuildStatisticsPanel()
 
 // === 缺失的行生成函数 ===
 
-TSharedRef<ITableRow> SObjRefDebuggerWindow::OnGenerateObjectRow(TSharedPtr<FObjectListItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+/** 实例列表的多列行，每一列的内容由窗口生成 */
+class SObjRefInstanceRow : public SMultiColumnTableRow<TWeakObjectPtr<UObject>>
+{
+public:
+	DECLARE_DELEGATE_RetVal_OneParam(TSharedRef<SWidget>, FOnGenerateCell, const FName& /*ColumnId*/);
+
+	SLATE_BEGIN_ARGS(SObjRefInstanceRow) {}
+		SLATE_EVENT(FOnGenerateCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		OnGenerateCell = InArgs._OnGenerateCell;
+		SMultiColumnTableRow<TWeakObjectPtr<UObject>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		return OnGenerateCell.IsBound() ? OnGenerateCell.Execute(ColumnName) : SNullWidget::NullWidget;
+	}
+
+private:
+	FOnGenerateCell OnGenerateCell;
+};
+
+TSharedRef<ITableRow> SObjRefDebuggerWindow::OnGenerateObjectRow(TWeakObjectPtr<UObject> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SObjRefInstanceRow, OwnerTable)
+		.OnGenerateCell(this, &SObjRefDebuggerWindow::GenerateObjectCell, Item);
+}
+
+TSharedRef<SWidget> SObjRefDebuggerWindow::GenerateObjectCell(const FName& ColumnId, TWeakObjectPtr<UObject> Item)
+{
+	EObjRefInstanceColumn Column;
+	if (!FObjRefInstanceView::FindColumn(ColumnId, Column))
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	// 只有真正显示的行才会走到这里，对象名称在此时才格式化并缓存，类名和世界名取自结果表的名称表
+	const int32 Row = InstanceTable->FindRow(Item.Get());
+
+	// 统计列可能在行生成之后才写入，显示时再按对象查找行
+	auto FindRow = [this, Item]() -> int32
+	{
+		return InstanceTable->FindRow(Item.Get());
+	};
+
+	TSharedRef<STextBlock> Cell = SNew(STextBlock)
+		.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"));
+
+	// 上次刷新新增的实例高亮显示；行控件在之后的刷新中会被复用，颜色按当前差异求值
+	Cell->SetColorAndOpacity(TAttribute<FSlateColor>::Create([this, Item]() -> FSlateColor
+	{
+		return IsAddedInstance(Item) ? FSlateColor(FDebuggerTheme::Get().AddedRowColor) : FSlateColor::UseForeground();
+	}));
+
+	switch (Column)
+	{
+	case EObjRefInstanceColumn::Name:
+		Cell->SetText(Row != INDEX_NONE ? RowTextCache->GetObjectName(*InstanceTable, Row) : LOCTEXT("CollectedObject", "已被回收"));
+		Cell->SetFont(FEditorStyle::GetFontStyle("PropertyWindow.BoldFont"));
+		if (Row != INDEX_NONE && CurrentClassNames.Num() > 1)
+		{
+			Cell->SetToolTipText(FText::FromString(FString::Printf(TEXT("匹配: %s"), *InstanceTable->GetMatchedClassNames(Row))));
+		}
+		break;
+
+	case EObjRefInstanceColumn::Class:
+		Cell->SetText(FText::FromString(Row != INDEX_NONE ? InstanceTable->GetClassName(Row) : TEXT("Unknown")));
+		break;
+
+	case EObjRefInstanceColumn::World:
+		Cell->SetText(FText::FromString(Row != INDEX_NONE ? InstanceTable->GetWorldName(Row) : TEXT("Unknown")));
+		break;
+
+	case EObjRefInstanceColumn::MemorySize:
+		Cell->SetText(TAttribute<FText>::Create([this, FindRow]()
+		{
+			const int32 CurrentRow = FindRow();
+			if (!CurrentFilterOptions.bShowMemoryInfo || CurrentRow == INDEX_NONE)
+			{
+				return FText::GetEmpty();
+			}
+			const int64 MemorySize = InstanceTable->GetMemorySizes()[CurrentRow];
+			return InstanceTable->HasExclusiveSizes() ?
+				FText::FromString(FString::Printf(TEXT("%.2f KB"), MemorySize / 1024.0)) :
+				FText::FromString(FString::Printf(TEXT("%lld 字节"), MemorySize));
+		}));
+		Cell->SetToolTipText(LOCTEXT("MemorySizeColumnTooltip", "统计资源内存时为独占内存，否则为类的结构体大小"));
+		break;
+
+	case EObjRefInstanceColumn::ReferenceCount:
+		Cell->SetText(TAttribute<FText>::Create([this, FindRow]()
+		{
+			const int32 CurrentRow = FindRow();
+			return CurrentRow != INDEX_NONE && InstanceTable->HasReferenceCounts() ?
+				FText::AsNumber(InstanceTable->GetReferenceCounts()[CurrentRow]) :
+				FText::FromString(TEXT("-"));
+		}));
+		break;
+
+	case EObjRefInstanceColumn::RetainedSize:
+		Cell->SetText(TAttribute<FText>::Create([this, FindRow]()
+		{
+			const int32 CurrentRow = FindRow();
+			if (!CurrentFilterOptions.bComputeRetainedSize || CurrentRow == INDEX_NONE)
+			{
+				return FText::FromString(TEXT("-"));
+			}
+			const int64 RetainedSize = InstanceTable->GetRetainedSizes()[CurrentRow];
+			return RetainedSize >= 0 ?
+				FText::FromString(FString::Printf(TEXT("%.2f KB"), RetainedSize / 1024.0)) :
+				LOCTEXT("RetainedSizeUnreachable", "不可达");
+		}));
+		break;
+	}
+
+	return SNew(SBox)
+		.VAlign(VAlign_Center)
+		.Padding(FMargin(4.0f, 2.0f))
+		[
+			Cell
+		];
+}
+
+void SObjRefDebuggerWindow::OnInstanceColumnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type SortMode)
 {
-	return SNew(STableRow<TSharedPtr<FObjectListItem>>, OwnerTable)
+	EObjRefInstanceColumn Column;
+	if (!FObjRefInstanceView::FindColumn(ColumnId, Column))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	InstanceView->SetSort(Column, SortMode);
+	RefreshInstanceList();
+	UE_LOG(LogTemp, Log, TEXT("按 %s 排序 %d 行，用时 %.1f 毫秒"), *ColumnId.ToString(), InstanceTable->Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+EColumnSortMode::Type SObjRefDebuggerWindow::GetInstanceColumnSortMode(FName ColumnId) const
+{
+	EObjRefInstanceColumn Column;
+	return FObjRefInstanceView::FindColumn(ColumnId, Column) ? InstanceView->GetSortMode(Column) : EColumnSortMode::None;
+}
+
+void SObjRefDebuggerWindow::OnInstanceFilterTextChanged(const FText& FilterText)
+{
+	InstanceView->SetFilterText(FilterText.ToString());
+	RefreshInstanceList();
+}
+
+TSharedRef<ITableRow> SObjRefDebuggerWindow::OnGenerateRemovedInstanceRow(TSharedPtr<FRemovedInstanceInfo> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<FRemovedInstanceInfo>>, OwnerTable)
+		.ToolTipText(Item->bCollected ?
+			LOCTEXT("RemovedCollectedTooltip", "对象已被回收") :
+			LOCTEXT("RemovedFilteredTooltip", "对象仍然存在，但不再满足搜索条件"))
 		[
 			SNew(SHorizontalBox)
 
 			+ SHorizontalBox::Slot()
 			.FillWidth(1.0f)
 			.VAlign(VAlign_Center)
+			.Padding(5.0f, 2.0f)
 			[
-				SNew(SVerticalBox)
-
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(Item->ObjectName))
-					.Font(FEditorStyle::GetFontStyle("PropertyWindow.BoldFont"))
-				]
-
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(SHorizontalBox)
-
-					+ SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(STextBlock)
-						.Text(FText::FromString(FString::Printf(TEXT("类: %s"), *Item->ClassName)))
-						.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
-						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
-					]
-
-					+ SHorizontalBox::Slot()
-					.AutoWidth()
-					.Padding(10, 0, 0, 0)
-					[
-						SNew(STextBlock)
-						.Text(FText::FromString(FString::Printf(TEXT("世界: %s"), *Item->WorldName)))
-						.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
-						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
-					]
+				SNew(STextBlock)
+				.Text(FText::FromString(Item->ObjectName))
+				.Font(FEditorStyle::GetFontStyle("PropertyWindow.BoldFont"))
+				.ColorAndOpacity(FDebuggerTheme::Get().RemovedRowColor)
+			]
 
-					+ SHorizontalBox::Slot()
-					.AutoWidth()
-					.Padding(10, 0, 0, 0)
-					[
-						SNew(STextBlock)
-						.Text_Lambda([this, Item]()
-						{
-							return CurrentFilterOptions.bShowMemoryInfo ?
-								FText::FromString(FString::Printf(TEXT("内存: %d 字节"), Item->MemorySize)) :
-								FText::GetEmpty();
-						})
-						.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
-						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
-						.Visibility_Lambda([this]()
-						{
-							return CurrentFilterOptions.bShowMemoryInfo ? EVisibility::Visible : EVisibility::Collapsed;
-						})
-					]
-				]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(5.0f, 2.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%s | %s | %.2f KB"), *Item->ClassName, *Item->WorldName, Item->MemorySize / 1024.0)))
+				.Font(FEditorStyle::GetFontStyle("PropertyWindow.NormalFont"))
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
 			]
 		];
 }
@@ -752,6 +1111,10 @@ TSharedRef<ITableRow> SObjRefDebuggerWindow::OnGenerateReferenceChainRow(TShared
 	{
 		RowColor = FDebuggerTheme::Get().GCRootColor;
 	}
+	else if (Item->ClusterSize > 1)
+	{
+		RowColor = FDebuggerTheme::Get().ClusterColor;
+	}
 	else if (Item->Depth == 1)
 	{
 		RowColor = FDebuggerTheme::Get().DirectReferenceColor;
@@ -831,7 +1194,7 @@ FReply SObjRefDebuggerWindow::OnSearchClicked()
 	UE_LOG(LogTemp, Log, TEXT("OnSearchClicked 被调用，当前类数量: %d, 正在搜索: %s"), 
 		CurrentClassNames.Num(), bIsSearching ? TEXT("是") : TEXT("否"));
 		
-	if (CurrentClassNames.Num() > 0 && !bIsSearching)
+	if (HasSearchCriteria())
 	{
 		// 生成缓存键并清除缓存以强制重新搜索
 		TArray<FString> ClassNameStrings;
@@ -843,32 +1206,32 @@ FReply SObjRefDebuggerWindow::OnSearchClicked()
 				UE_LOG(LogTemp, Log, TEXT("准备搜索类: %s"), **ClassName);
 			}
 		}
-		FString CacheKey = FString::Join(ClassNameStrings, TEXT(","));
+		FString CacheKey = MakeSearchCacheKey(ClassNameStrings);
 		UE_LOG(LogTemp, Log, TEXT("生成的缓存键: %s"), *CacheKey);
 		
 		// 清除缓存强制重新搜索
 		CachedSearchResults.Remove(CacheKey);
 		UE_LOG(LogTemp, Log, TEXT("已清除缓存，强制重新搜索"));
 
-		// 启动异步搜索
+		// 启动异步搜索，正在进行的搜索会被取代
 		UE_LOG(LogTemp, Log, TEXT("启动多类搜索"));
 		StartAsyncMultiClassSearch(ClassNameStrings);
 	}
 	else
 	{
-		if (CurrentClassNames.Num() == 0)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("没有选择任何类"));
-		}
-		if (bIsSearching)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("当前正在搜索中"));
-		}
+		UE_LOG(LogTemp, Warning, TEXT("没有选择任何类，也没有输入查询条件"));
 	}
 	
 	return FReply::Handled();
 }
 
+FReply SObjRefDebuggerWindow::OnCancelSearchClicked()
+{
+	CancelSearch();
+	UE_LOG(LogTemp, Log, TEXT("已取消搜索"));
+	return FReply::Handled();
+}
+
 void SObjRefDebuggerWindow::OnClassSelected(UClass* SelectedClass)
 {
 	if (SelectedClass)
@@ -914,47 +1277,58 @@ void SObjRefDebuggerWindow::OnClassSelected(UClass* SelectedClass)
 	}
 }
 
-void SObjRefDebuggerWindow::OnObjectSelectionChanged(TSharedPtr<FObjectListItem> SelectedItem, ESelectInfo::Type SelectInfo)
+void SObjRefDebuggerWindow::OnObjectSelectionChanged(TWeakObjectPtr<UObject> SelectedItem, ESelectInfo::Type SelectInfo)
 {
 	CurrentSelectedObject = SelectedItem;
 	ReferencerInfos.Empty();
 	ReferenceChainRoots.Empty();
 	
-	if (SelectedItem.IsValid() && IsValid(SelectedItem->Object))
+	// 上一个对象尚未完成的引用分析作废，快速切换选择时不会堆积过时的工作
+	const FObjRefJobToken Token = AnalysisJobs.BeginJob();
+	
+	if (IsValid(SelectedItem.Get()))
 	{
-		UObject* TargetObject = SelectedItem->Object;
+		UObject* TargetObject = SelectedItem.Get();
 		UE_LOG(LogTemp, Log, TEXT("选择了对象: %s"), *TargetObject->GetName());
 		
-		// 检查引用者缓存
-		if (CachedReferencers.Contains(TargetObject))
+		// 缓存只对引用图的当前状态有效：先应用增量变化，再读取GC周期与版本，任意一个变化后整体清空
+		ReferenceGraph->EnsureUpToDate();
+		const FObjRefAnalysisStamp Stamp = FObjRefAnalysisStamp::FromGraph(*ReferenceGraph);
+		AnalysisCache->SetBudget(static_cast<SIZE_T>(CurrentFilterOptions.AnalysisCacheBudgetMB) * 1024 * 1024);
+		
+		// 引用者从引用图的 CSR 邻接中读取，缓存省去的是属性名解析与文本格式化
+		if (const TArray<TSharedPtr<FReferencerInfo>>* CachedReferencers = AnalysisCache->FindReferencers(TargetObject, Stamp))
 		{
-			UE_LOG(LogTemp, Log, TEXT("使用缓存的引用者信息"));
-			ReferencerInfos = CachedReferencers[TargetObject];
+			ReferencerInfos = *CachedReferencers;
 		}
 		else
 		{
-			UE_LOG(LogTemp, Log, TEXT("查找对象引用者"));
-			// 查找引用者
 			FindObjectReferencers(TargetObject, ReferencerInfos);
-			// 缓存结果
-			CachedReferencers.Add(TargetObject, ReferencerInfos);
+			AnalysisCache->AddReferencers(TargetObject, Stamp, ReferencerInfos);
 		}
 		
 		// 构建引用链（如果启用）
 		if (CurrentFilterOptions.bShowReferenceChain)
 		{
 			// 检查引用链缓存
-			if (CachedReferenceChains.Contains(TargetObject))
+			if (const TArray<TSharedPtr<FReferenceChainNode>>* CachedChains = AnalysisCache->FindReferenceChains(TargetObject, Stamp))
+			{
+				UE_LOG(LogTemp, Log, TEXT("使用缓存的引用链信息（命中 %llu 次，未命中 %llu 次，缓存 %d 个对象 / %.1f KB）"),
+					AnalysisCache->GetNumHits(), AnalysisCache->GetNumMisses(), AnalysisCache->Num(), AnalysisCache->GetUsedBytes() / 1024.0);
+				ReferenceChainRoots = *CachedChains;
+			}
+			else if (CurrentFilterOptions.ReferenceChainMode == EReferenceChainMode::ShortestPath)
 			{
-				UE_LOG(LogTemp, Log, TEXT("使用缓存的引用链信息"));
-				ReferenceChainRoots = CachedReferenceChains[TargetObject];
+				// 最短路径搜索可能访问大半个堆，交给工作线程，完成后再写入缓存
+				UE_LOG(LogTemp, Log, TEXT("在工作线程上查找最短引用链"));
+				StartShortestChainAnalysis(TargetObject, Token);
 			}
 			else
 			{
 				UE_LOG(LogTemp, Log, TEXT("构建引用链到GC根"));
 				BuildReferenceChainToRoot(TargetObject, ReferenceChainRoots);
 				// 缓存结果
-				CachedReferenceChains.Add(TargetObject, ReferenceChainRoots);
+				AnalysisCache->AddReferenceChains(TargetObject, Stamp, ReferenceChainRoots);
 			}
 		}
 	}
@@ -975,7 +1349,7 @@ void SObjRefDebuggerWindow::OnReferenceChainSelectionChanged(TSharedPtr<FReferen
 void SObjRefDebuggerWindow::OnFilterOptionChanged()
 {
 	// 当过滤选项改变时，如果有缓存的结果则重新过滤
-	if (CurrentClassNames.Num() > 0)
+	if (HasSearchCriteria())
 	{
 		TArray<FString> ClassNameStrings;
 		for (const TSharedPtr<FString>& ClassName : CurrentClassNames)
@@ -985,7 +1359,7 @@ void SObjRefDebuggerWindow::OnFilterOptionChanged()
 				ClassNameStrings.Add(*ClassName);
 			}
 		}
-		FString CacheKey = FString::Join(ClassNameStrings, TEXT(","));
+		FString CacheKey = MakeSearchCacheKey(ClassNameStrings);
 		
 		if (CachedSearchResults.Contains(CacheKey))
 		{
@@ -1003,6 +1377,16 @@ void SObjRefDebuggerWindow::OnGetReferenceChainChildren(TSharedPtr<FReferenceCha
 	}
 }
 
+void SObjRefDebuggerWindow::OnReferenceChainExpansionChanged(TSharedPtr<FReferenceChainNode> Item, bool bExpanded)
+{
+	// 第一次展开时把占位节点替换为真正的引用者，之后直接复用已生成的子节点
+	if (bExpanded && Item.IsValid() && Item->bChildrenPending)
+	{
+		ExpandReferenceChainNode(Item);
+		ReferenceChainTreeView->RequestTreeRefresh();
+	}
+}
+
 TSharedRef<ITableRow> SObjRefDebuggerWindow::OnGenerateSelectedClassRow(TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	if (!Item.IsValid())
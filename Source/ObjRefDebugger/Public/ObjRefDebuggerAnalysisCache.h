@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "ObjRefDebuggerTypes.h"
+
+class FObjRefReferenceGraph;
+
+/**
+ * 分析结果对应的引用图状态
+ * 两次GC之间引用图也会增量更新，引用者列表随之变化，所以同时记录GC周期与引用图版本
+ */
+struct FObjRefAnalysisStamp
+{
+	uint32 GCEpoch;
+	uint32 GraphVersion;
+
+	FObjRefAnalysisStamp()
+		: GCEpoch(0)
+		, GraphVersion(0)
+	{
+	}
+
+	/** 引用图当前的状态，调用前应先 EnsureUpToDate，否则尚未应用的变化不会反映在版本中 */
+	static FObjRefAnalysisStamp FromGraph(const FObjRefReferenceGraph& Graph);
+
+	bool operator==(const FObjRefAnalysisStamp& Other) const { return GCEpoch == Other.GCEpoch && GraphVersion == Other.GraphVersion; }
+
+	/** 是否比 Other 新，按 uint32 回绕比较：先比较GC周期，周期相同时比较版本 */
+	bool IsNewerThan(const FObjRefAnalysisStamp& Other) const;
+};
+
+/**
+ * 选择对象后的引用分析结果缓存（引用者列表与引用链树）
+ * 按 FObjectKey（索引 + 序列号）缓存，对象槽位被复用后不会读到另一个对象的结果。
+ * 结果中的引用者和链节点持有对象裸指针，引用者列表还会随引用图的增量更新变化：
+ * 缓存记录写入时的GC周期与引用图版本，查询或写入时任意一个变化就整体清空。
+ * 缓存按估算的字节数限制大小，超出预算时淘汰最久未使用的对象；命中、未命中与淘汰次数单独统计。
+ * 只在游戏线程使用。
+ */
+class FObjRefAnalysisCache
+{
+public:
+	explicit FObjRefAnalysisCache(SIZE_T InBudgetBytes);
+
+	/** 设置字节预算，缩小时立即淘汰 */
+	void SetBudget(SIZE_T InBudgetBytes);
+
+	/** 查找对象的引用者列表，Stamp 为引用图当前的状态，未命中返回 nullptr */
+	const TArray<TSharedPtr<FReferencerInfo>>* FindReferencers(const UObject* Object, const FObjRefAnalysisStamp& Stamp);
+
+	/** 查找对象的引用链树，未命中返回 nullptr */
+	const TArray<TSharedPtr<FReferenceChainNode>>* FindReferenceChains(const UObject* Object, const FObjRefAnalysisStamp& Stamp);
+
+	/** 写入引用者列表，Stamp 为结果计算时引用图的状态，已过期的结果不会写入 */
+	void AddReferencers(const UObject* Object, const FObjRefAnalysisStamp& Stamp, const TArray<TSharedPtr<FReferencerInfo>>& Referencers);
+
+	/** 写入引用链树 */
+	void AddReferenceChains(const UObject* Object, const FObjRefAnalysisStamp& Stamp, const TArray<TSharedPtr<FReferenceChainNode>>& ChainRoots);
+
+	/** 丢弃所有引用链（引用链模式变化后），保留引用者列表 */
+	void ResetReferenceChains();
+
+	/** 清空缓存，统计计数保留 */
+	void Reset();
+
+	/** 当前缓存的对象数 */
+	int32 Num() const { return EntryIndexByKey.Num(); }
+
+	/** 缓存内容估算占用的字节数 */
+	SIZE_T GetUsedBytes() const { return UsedBytes; }
+	SIZE_T GetBudget() const { return BudgetBytes; }
+
+	uint64 GetNumHits() const { return NumHits; }
+	uint64 GetNumMisses() const { return NumMisses; }
+	uint64 GetNumEvictions() const { return NumEvictions; }
+
+	/** 估算引用者列表占用的字节数 */
+	static SIZE_T MeasureReferencers(const TArray<TSharedPtr<FReferencerInfo>>& Referencers);
+
+	/** 估算引用链树占用的字节数（包括展开后生成的子节点） */
+	static SIZE_T MeasureReferenceChains(const TArray<TSharedPtr<FReferenceChainNode>>& ChainRoots);
+
+private:
+	/** 一个对象的缓存项，通过 Prev/Next 串成LRU链表，表头为最近使用的项 */
+	struct FEntry
+	{
+		FObjectKey Key;
+		TArray<TSharedPtr<FReferencerInfo>> Referencers;
+		TArray<TSharedPtr<FReferenceChainNode>> ChainRoots;
+		bool bHasReferencers;
+		bool bHasChains;
+		SIZE_T Bytes;
+		int32 Prev;
+		int32 Next;
+	};
+
+	/** 引用图状态变新时清空缓存，返回 Stamp 是否为当前状态 */
+	bool SyncStamp(const FObjRefAnalysisStamp& Stamp);
+
+	/** 查找对象的缓存项并移到表头，没有时返回 INDEX_NONE */
+	int32 Touch(const UObject* Object);
+
+	/** 查找或新建对象的缓存项并移到表头 */
+	int32 FindOrAddEntry(const UObject* Object);
+
+	/** 重新估算缓存项大小并更新总字节数 */
+	void UpdateEntryBytes(int32 EntryIndex);
+
+	/** 淘汰链表尾部的项直到不超出预算，KeepIndex 为刚写入的项，不会被淘汰 */
+	void EvictToBudget(int32 KeepIndex);
+
+	void RemoveEntry(int32 EntryIndex);
+	void LinkAtHead(int32 EntryIndex);
+	void Unlink(int32 EntryIndex);
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	TMap<FObjectKey, int32> EntryIndexByKey;
+	int32 Head;
+	int32 Tail;
+
+	SIZE_T BudgetBytes;
+	SIZE_T UsedBytes;
+
+	/** 缓存内容对应的引用图状态 */
+	FObjRefAnalysisStamp CachedStamp;
+
+	uint64 NumHits;
+	uint64 NumMisses;
+	uint64 NumEvictions;
+};
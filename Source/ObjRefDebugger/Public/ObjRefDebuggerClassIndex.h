@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * 类名到 UClass 的索引
+ * 用引擎的类哈希枚举所有 UClass 一次，之后按路径名或短名查找只需 O(1)。
+ * 模块加载、热重载、蓝图编译、蓝图资源加载以及类包加载/卸载时作废，下次查找时重建。
+ * 找不到的名字记录在未命中缓存中，索引作废前重复查找不会再重建。
+ * 只能在游戏线程使用。
+ */
+class FObjRefClassIndex
+{
+public:
+	FObjRefClassIndex();
+	~FObjRefClassIndex();
+
+	/**
+	 * 按类名查找类
+	 * @param ClassName 短名（如 StaticMeshComponent）或路径名（如 /Script/Engine.StaticMeshComponent）
+	 * 短名重复时优先原生类；只在索引作废后重建
+	 */
+	UClass* FindClass(const FString& ClassName);
+
+	/** 作废索引并清空未命中缓存，下次查找时重建 */
+	void Invalidate();
+
+	/** 索引中的类数量 */
+	int32 Num() const { return ClassesByPath.Num(); }
+
+private:
+	/** 枚举所有有效的 UClass 重建索引 */
+	void Rebuild();
+
+	/** 在当前索引中查找，不触发重建 */
+	UClass* FindClassInIndex(const FString& ClassName) const;
+
+	/** 类是否可以出现在索引中（排除被重新编译替代的旧版本和临时类） */
+	static bool IsIndexableClass(const UClass* Class);
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void OnAssetLoaded(UObject* Asset);
+
+	/** 路径名 -> 类 */
+	TMap<FName, TWeakObjectPtr<UClass>> ClassesByPath;
+
+	/** 短名 -> 类，同名类按原生优先排列 */
+	TMap<FName, TArray<TWeakObjectPtr<UClass>, TInlineAllocator<1>>> ClassesByName;
+
+	/** 当前索引中找不到的类名 */
+	TSet<FString> MissedNames;
+
+	bool bIsDirty;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ClassPackageLoadedHandle;
+	FDelegateHandle AssetLoadedHandle;
+};
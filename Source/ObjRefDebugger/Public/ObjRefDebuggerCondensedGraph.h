@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ObjRefDebuggerReferenceGraph.h"
+
+/** 缩合图上的一条反向边：SourceComponent 中的 SourceIndex 通过 PropertyId 引用了目标分量中的 TargetIndex */
+struct FObjRefCondensedEdge
+{
+	int32 SourceComponent;
+	int32 SourceIndex;
+	int32 TargetIndex;
+	int32 PropertyId;
+
+	FObjRefCondensedEdge(int32 InSourceComponent, int32 InSourceIndex, int32 InTargetIndex, int32 InPropertyId)
+		: SourceComponent(InSourceComponent)
+		, SourceIndex(InSourceIndex)
+		, TargetIndex(InTargetIndex)
+		, PropertyId(InPropertyId)
+	{
+	}
+};
+
+/**
+ * 强连通分量缩合图
+ * 用迭代式 Tarjan 算法把引用图中互相引用的对象（Actor ↔ 组件 ↔ Owner 等）合并为一个分量，
+ * 分量之间的引用构成有向无环图，引用链在其上展开时不会再出现重复的循环子树。
+ * 每对分量之间只保留一条代表边用于显示属性名。
+ */
+class FObjRefCondensedGraph
+{
+public:
+	FObjRefCondensedGraph();
+
+	/** 在引用图上计算强连通分量和缩合图 */
+	void Compute(const FObjRefReferenceGraph& Graph);
+
+	/**
+	 * 结果是否仍然可用
+	 * 缩合图按GC周期缓存，两次GC之间引用图的增量更新不会触发全堆重算；
+	 * 这期间新建的对象没有分量，由调用方在用到时通过 IsLatestVersion 判断是否需要重算
+	 */
+	bool IsUpToDate(const FObjRefReferenceGraph& Graph) const;
+
+	/** 结果是否对应引用图的当前版本（包括尚未应用的增量变化） */
+	bool IsLatestVersion(const FObjRefReferenceGraph& Graph) const;
+
+	/** 清空结果 */
+	void Reset();
+
+	/** 对象所在的分量，对象无效时返回 INDEX_NONE */
+	int32 GetComponent(int32 ObjectIndex) const { return ComponentIds.IsValidIndex(ObjectIndex) ? ComponentIds[ObjectIndex] : INDEX_NONE; }
+
+	/** 分量数 */
+	int32 GetNumComponents() const { return ComponentRootKinds.Num(); }
+
+	/** 分量包含的对象索引 */
+	TArrayView<const int32> GetMembers(int32 ComponentId) const;
+
+	/** 分量包含的对象数 */
+	int32 GetComponentSize(int32 ComponentId) const { return GetMembers(ComponentId).Num(); }
+
+	/** 分量中第一个GC根的类型，不含GC根时返回 None */
+	EObjRefRootKind GetRootKind(int32 ComponentId) const { return ComponentRootKinds.IsValidIndex(ComponentId) ? static_cast<EObjRefRootKind>(ComponentRootKinds[ComponentId]) : EObjRefRootKind::None; }
+
+	/** 引用该分量的其他分量，每个引用分量一条代表边 */
+	TArrayView<const FObjRefCondensedEdge> GetReferencingComponents(int32 ComponentId) const;
+
+	/** 缩合图占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** 对象索引 -> 分量ID */
+	TArray<int32> ComponentIds;
+
+	/** 分量成员：分量 c 的成员位于 Members[MemberOffsets[c] .. MemberOffsets[c+1]) */
+	TArray<int32> MemberOffsets;
+	TArray<int32> Members;
+
+	/** 每个分量的 EObjRefRootKind */
+	TArray<uint8> ComponentRootKinds;
+
+	/** 缩合后的反向邻接 */
+	TArray<int32> InEdgeOffsets;
+	TArray<FObjRefCondensedEdge> InEdges;
+
+	/** 计算时引用图的GC周期与版本 */
+	uint32 ComputedGCEpoch;
+	uint32 ComputedGraphVersion;
+	bool bHasResult;
+};
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FObjRefReferenceGraph;
+
+/**
+ * 支配树与保留大小
+ * 以所有GC根为后继的虚拟根作为起点，在引用图上运行 Lengauer-Tarjan 算法求出每个对象的直接支配者，
+ * 对象的保留大小即支配树中以它为根的子树的自身大小之和，也就是它被回收时能一起释放的内存。
+ */
+class FObjRefDominatorTree
+{
+public:
+	FObjRefDominatorTree();
+
+	/**
+	 * 在引用图上计算支配树和保留大小
+	 * @param GetSelfSize 返回对象自身大小（字节），只会对存活且可达的对象调用
+	 */
+	void Compute(const FObjRefReferenceGraph& Graph, TFunctionRef<int64(UObject* Object)> GetSelfSize);
+
+	/**
+	 * 结果是否仍然可用
+	 * 支配树按GC周期缓存：两次GC之间引用图的增量更新不会触发全堆重算，
+	 * 这期间新建的对象没有结果，按不可达显示，直到下一次GC后重新计算
+	 */
+	bool IsUpToDate(const FObjRefReferenceGraph& Graph) const;
+
+	/** 对象的保留大小，不可达或不在图中时返回 INDEX_NONE */
+	int64 GetRetainedSize(int32 ObjectIndex) const { return RetainedSizes.IsValidIndex(ObjectIndex) ? RetainedSizes[ObjectIndex] : INDEX_NONE; }
+
+	/** 对象的直接支配者；直接由GC根集合支配或不可达时返回 INDEX_NONE */
+	int32 GetImmediateDominator(int32 ObjectIndex) const { return ImmediateDominators.IsValidIndex(ObjectIndex) ? ImmediateDominators[ObjectIndex] : INDEX_NONE; }
+
+	/** 清空结果 */
+	void Reset();
+
+private:
+	/** 按对象索引存放的保留大小与直接支配者 */
+	TArray<int64> RetainedSizes;
+	TArray<int32> ImmediateDominators;
+
+	/** 计算时引用图的GC周期 */
+	uint32 ComputedGCEpoch;
+	bool bHasResult;
+};
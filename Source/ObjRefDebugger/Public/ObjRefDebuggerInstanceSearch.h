@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "ObjRefDebuggerTypes.h"
+#include "ObjRefDebuggerJobToken.h"
+#include "ObjRefDebuggerQuery.h"
+#include "ObjRefDebuggerWorldCache.h"
+
+class UWorld;
+
+/** 实例搜索请求，在游戏线程上准备好后可交给任意线程执行 */
+struct FObjRefSearchRequest
+{
+	/** 目标类，匹配结果中的下标对应此数组 */
+	TArray<TWeakObjectPtr<UClass>> TargetClasses;
+
+	/** 排除的类，属于这些类（含子类）的对象不参与匹配 */
+	TArray<TWeakObjectPtr<UClass>> ExcludedClasses;
+
+	/** 所选世界，Actor 目标类只匹配这些世界中的 Actor */
+	TArray<TWeakObjectPtr<UWorld>> Worlds;
+
+	/** 编译后的查询，对象阶段的谓词在工作线程上对每个候选对象求值 */
+	FObjRefQuery Query;
+
+	/** 查询选择 Outer 或包作为候选来源时解析出的对象，为空时按类哈希枚举候选 */
+	TWeakObjectPtr<UObject> CandidateScope;
+
+	FSearchFilterOptions FilterOptions;
+};
+
+/** 一个搜索结果：对象的弱引用、它匹配的目标类下标与搜索时解析出的世界 */
+struct FObjRefSearchMatch
+{
+	FWeakObjectPtr Object;
+	int32 ObjectIndex;
+
+	/** 对象所在世界的对象索引，没有世界时为 INDEX_NONE */
+	int32 WorldIndex;
+
+	TArray<int32, TInlineAllocator<2>> MatchedTargets;
+
+	FObjRefSearchMatch()
+		: ObjectIndex(INDEX_NONE)
+		, WorldIndex(INDEX_NONE)
+	{
+	}
+};
+
+/**
+ * 并行实例搜索
+ * 持有GC锁，把候选对象分块交给 ParallelFor 在各工作线程上过滤，结果按对象索引合并。
+ * 候选对象默认来自引擎的类哈希；目标包含 UObject 时改为按索引区间分块扫描整个 GUObjectArray；
+ * 查询中有精确的 outer:、within: 或 package: 条件（包括搜索范围选择器）时改由 Outer 哈希或包哈希枚举，
+ * 代价只与该范围内的对象数有关。
+ * 每次搜索建立一张按 Outer 缓存的世界表，所有工作线程共用，世界过滤和结果的世界列都只需查表。
+ */
+class FObjRefInstanceSearch
+{
+public:
+	/**
+	 * 执行搜索，可在任意线程调用，结果按对象索引排列
+	 * 各分块开始前检查取消令牌，令牌失效时尽快释放GC锁并返回 false
+	 */
+	static bool Run(const FObjRefSearchRequest& Request, TArray<FObjRefSearchMatch>& OutMatches, const FObjRefJobToken& CancelToken = FObjRefJobToken());
+
+	/** 扫描对象数组时每个任务处理的索引区间长度 */
+	static constexpr int32 ObjectsPerChunk = 16 * 1024;
+
+	/** 过滤类哈希候选时每个任务处理的对象数 */
+	static constexpr int32 CandidatesPerChunk = 1024;
+};
+
+/**
+ * 分帧实例搜索
+ * 在游戏线程上按时间预算逐段扫描 GUObjectArray，每帧只处理预算内的对象，匹配结果逐帧产出，
+ * 百万级对象的堆上也不会让编辑器卡顿。结果只交给调用方，由调用方以弱引用保存，两帧之间可能发生GC。
+ * 查询有 Outer 或包范围时开始时收集一次范围内的候选，逐帧只检查这些对象。
+ */
+class FObjRefTimeSlicedSearch
+{
+public:
+	explicit FObjRefTimeSlicedSearch(const FObjRefSearchRequest& InRequest);
+
+	/** 在时间预算内继续扫描，本次新找到的结果追加到 OutNewMatches，扫描完成时返回 true */
+	bool Step(double BudgetSeconds, TArray<FObjRefSearchMatch>& OutNewMatches);
+
+	/** 扫描进度 [0, 1] */
+	float GetProgress() const;
+
+	bool IsComplete() const { return bIsComplete; }
+
+	const FObjRefSearchRequest& GetRequest() const { return Request; }
+
+	/** 两帧之间发生了GC：世界缓存中的对象索引已失效 */
+	void OnGarbageCollected();
+
+	/** 每扫描这么多个对象检查一次时间预算 */
+	static constexpr int32 ObjectsPerTimeCheck = 1024;
+
+private:
+	FObjRefSearchRequest Request;
+
+	/** 下一个要检查的对象索引；有查询范围时为 ScopeCandidates 中的位置 */
+	int32 NextObjectIndex;
+
+	/** 查询范围内的对象索引，按升序排列 */
+	TArray<int32> ScopeCandidates;
+	bool bHasScope;
+
+	/** 跨帧复用的世界缓存，发生GC后重建 */
+	FObjRefWorldCache WorldCache;
+
+	bool bIsComplete;
+};
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+struct FObjRefSearchMatch;
+class FObjRefReferenceGraph;
+
+/** 结果行的对象标志 */
+enum class EObjRefRowFlags : uint8
+{
+	None = 0,
+	GCRoot = 1 << 0,      // 引用图中的GC根
+	RootSet = 1 << 1,     // 位于根集（AddToRoot）
+	Standalone = 1 << 2,  // RF_Standalone
+	Transient = 1 << 3,   // RF_Transient
+};
+ENUM_CLASS_FLAGS(EObjRefRowFlags);
+
+/** 同一搜索条件下两次结果之间的差异 */
+struct FObjRefTableDiff
+{
+	/** 新表中新增的行 */
+	TArray<int32> AddedRows;
+
+	/** 旧表中不再出现在新结果里的行（对象被回收、槽位被复用或不再满足条件） */
+	TArray<int32> RemovedRows;
+
+	int32 NumUnchanged = 0;
+};
+
+/**
+ * 实例搜索结果表（列式存储）
+ * 每一列是一个连续数组，同一下标对应同一行，行按对象索引排列；类名和世界名各自驻留为一张名称表，
+ * 行中只保存名称ID。统计与排序都是对单列的线性扫描，搜索时不格式化任何字符串。
+ * 列表控件的数据源是对象弱引用数组，显示时按对象回到本表二分查找对应的行。
+ * 只能在游戏线程使用。
+ */
+class FObjRefInstanceTable
+{
+public:
+	explicit FObjRefInstanceTable(const TArray<FName>& InTargetClassNames);
+
+	/** 追加搜索结果，已被回收的对象直接跳过 */
+	void Append(const TArray<FObjRefSearchMatch>& Matches);
+
+	/** 把从 FirstRow 开始的行追加为列表数据源的弱引用 */
+	void AppendHandles(TArray<TWeakObjectPtr<UObject>>& OutHandles, int32 FirstRow = 0) const;
+
+	/** 按给定的行顺序追加弱引用 */
+	void AppendHandles(TArray<TWeakObjectPtr<UObject>>& OutHandles, TArrayView<const int32> RowOrder) const;
+
+	/** 移除对象已被回收或槽位已被复用的行，返回移除的行数 */
+	int32 RemoveStaleRows();
+
+	/** 移除谓词返回 true 的行，其余行保持原有顺序，返回移除的行数 */
+	int32 RemoveRowsIf(TFunctionRef<bool(int32 Row)> ShouldRemove);
+
+	int32 Num() const { return ObjectIndices.Num(); }
+
+	/** 按对象查找行号，对象不在表中时返回 INDEX_NONE */
+	int32 FindRow(const UObject* Object) const;
+
+	/** 行对应的对象，对象已被回收或槽位已被复用时返回 nullptr */
+	UObject* ResolveRow(int32 Row) const;
+
+	/** 行匹配的目标类名，逗号分隔 */
+	FString GetMatchedClassNames(int32 Row) const;
+
+	/** 用独占内存替换内存列，Sizes 与行一一对应 */
+	void SetExclusiveSizes(const TArray<int64>& Sizes);
+
+	/**
+	 * 从引用图快照填充引用者数量列与GC根标志
+	 * 引用者数量是不同引用者对象的个数，同一对象通过多个属性引用时只计一次，与引用者面板一致
+	 */
+	void UpdateReferenceColumns(const FObjRefReferenceGraph& Graph);
+
+	/**
+	 * 比较两张表：两张表的行都按对象索引排列，一次归并即可得到差异，O(旧行数 + 新行数)
+	 * 对象索引与序列号都相同的行视为未变化，索引相同而序列号不同的槽位已被新对象复用，记为一删一增
+	 */
+	static void Diff(const FObjRefInstanceTable& OldTable, const FObjRefInstanceTable& NewTable, FObjRefTableDiff& OutDiff);
+
+	// 列
+	const TArray<int32>& GetObjectIndices() const { return ObjectIndices; }
+	const TArray<int32>& GetSerialNumbers() const { return SerialNumbers; }
+	const TArray<int32>& GetClassIds() const { return ClassIds; }
+	const TArray<int32>& GetWorldIds() const { return WorldIds; }
+	const TArray<int64>& GetMemorySizes() const { return MemorySizes; }
+	const TArray<int32>& GetReferenceCounts() const { return ReferenceCounts; }
+	const TArray<EObjRefRowFlags>& GetFlags() const { return Flags; }
+	TArray<int64>& GetRetainedSizes() { return RetainedSizes; }
+	const TArray<int64>& GetRetainedSizes() const { return RetainedSizes; }
+
+	/** 内存列是否已替换为独占内存，否则为类的结构体大小 */
+	bool HasExclusiveSizes() const { return bHasExclusiveSizes; }
+
+	/** 引用者数量列是否已从引用图填充 */
+	bool HasReferenceCounts() const { return bHasReferenceCounts; }
+
+	// 名称表
+	const TArray<FString>& GetClassNames() const { return ClassNames; }
+	const TArray<FString>& GetWorldNames() const { return WorldNames; }
+	const FString& GetClassName(int32 Row) const { return ClassNames[ClassIds[Row]]; }
+	const FString& GetWorldName(int32 Row) const { return WorldNames[WorldIds[Row]]; }
+	int32 GetClassStructureSize(int32 Row) const { return ClassStructureSizes[ClassIds[Row]]; }
+
+	const TArray<FName>& GetTargetClassNames() const { return TargetClassNames; }
+
+	/** 对象自身的标志（不含需要引用图的 GCRoot），可在工作线程调用 */
+	static EObjRefRowFlags GetObjectFlags(const UObject* Object);
+
+	/** 表占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** 驻留类名，返回类ID */
+	int32 InternClass(UClass* Class);
+
+	/**
+	 * 驻留对象所在世界的名称，返回世界ID（0 表示无世界）
+	 * @param WorldIndex 搜索时由世界缓存解析出的世界对象索引；该槽位已不是世界时重新解析
+	 */
+	int32 InternWorld(UObject* Object, int32 WorldIndex);
+
+	/** 按对象索引重新排列所有列 */
+	void SortByObjectIndex();
+
+	TArray<int32> ObjectIndices;
+	TArray<int32> SerialNumbers;
+	TArray<int32> ClassIds;
+	TArray<int32> WorldIds;
+	TArray<uint32> MatchedTargets;  // 多类搜索时匹配的目标类（位掩码，对应 TargetClassNames）
+	TArray<int64> MemorySizes;
+	TArray<int64> RetainedSizes;    // 保留大小，-1 表示未计算或从GC根不可达
+	TArray<int32> ReferenceCounts;
+	TArray<EObjRefRowFlags> Flags;
+
+	bool bHasExclusiveSizes;
+	bool bHasReferenceCounts;
+
+	TArray<FString> ClassNames;
+	TArray<int32> ClassStructureSizes;
+	TMap<int32, int32> ClassIdByObjectIndex;
+
+	TArray<FString> WorldNames;
+	TMap<int32, int32> WorldIdByObjectIndex;
+
+	TArray<FName> TargetClassNames;
+};
+
+/** 列表行的显示文本 */
+struct FObjRefRowText
+{
+	int32 SerialNumber;
+	FText ObjectName;
+};
+
+/**
+ * 列表行文本缓存
+ * 对象名称只在行第一次被显示时格式化（类名和世界名直接取自结果表的名称表）；
+ * 只保留最近显示过的行，超过容量时整体清空。
+ */
+class FObjRefRowTextCache
+{
+public:
+	/** 获取行的对象名称，未缓存时立即格式化 */
+	const FText& GetObjectName(const FObjRefInstanceTable& Table, int32 Row);
+
+	/** 查找已缓存的对象名称，对象被回收后仍可取得它最后一次显示的名称；没有缓存时返回 nullptr */
+	const FText* FindObjectName(int32 ObjectIndex, int32 SerialNumber) const;
+
+	void Reset() { Entries.Reset(); }
+
+	/** 缓存的最大行数，远大于一屏能显示的行数 */
+	static constexpr int32 MaxEntries = 1024;
+
+private:
+	/** 对象索引 -> 行文本，序列号不一致时视为失效 */
+	TMap<int32, FObjRefRowText> Entries;
+};
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "ObjRefDebuggerTrigramIndex.h"
+
+class FObjRefInstanceTable;
+
+/** 实例列表的列 */
+enum class EObjRefInstanceColumn : uint8
+{
+	Name,
+	Class,
+	World,
+	MemorySize,
+	ReferenceCount,
+	RetainedSize,
+};
+
+/**
+ * 实例列表的排序与过滤视图
+ * 在结果表之上维护排序后的行号和通过文本过滤的行，列表控件显示的就是 GetVisibleRows 的顺序。
+ * 排序先为每行生成一个 int64 排序键（名称按驻留的基础名排名 + 数字后缀，类和世界按名称表排名），
+ * 再对（键，行号）并行排序；过滤通过名称索引匹配对象名与 Outer 路径，输入加长时只保留上一次通过的行。
+ * 只能在游戏线程使用。
+ */
+class FObjRefInstanceView
+{
+public:
+	FObjRefInstanceView();
+
+	/** 绑定新的结果表，保留当前的排序与过滤条件 */
+	void SetTable(TSharedPtr<FObjRefInstanceTable> InTable);
+
+	/** 结果表的行被移除或统计列被更新后，按当前条件重新排序和过滤 */
+	void Refresh();
+
+	/**
+	 * 结果表末尾追加了行：只过滤新行并追加到可见行末尾，排序在下一次 Refresh 时恢复
+	 * @return 新行在可见行中的起始位置
+	 */
+	int32 AppendRows(int32 FirstNewRow);
+
+	void SetSort(EObjRefInstanceColumn Column, EColumnSortMode::Type Mode);
+	EColumnSortMode::Type GetSortMode(EObjRefInstanceColumn Column) const;
+
+	void SetFilterText(const FString& InFilterText);
+	const FString& GetFilterText() const { return FilterText; }
+
+	/** 排序并过滤后的行号 */
+	const TArray<int32>& GetVisibleRows() const { return VisibleRows; }
+
+	/** 列在表头中的ID */
+	static FName GetColumnId(EObjRefInstanceColumn Column);
+
+	/** 按表头列ID查找列，未知的列ID返回 false */
+	static bool FindColumn(const FName& ColumnId, EObjRefInstanceColumn& OutColumn);
+
+private:
+	/** 按当前排序列重建 SortedRows */
+	void SortRows();
+
+	/** 生成名称列的排序键并缓存，直到行号发生变化 */
+	void BuildNameSortKeys();
+
+	/**
+	 * 重新计算 [FirstRow, Num) 范围内每行是否通过过滤
+	 * @param bRefine 为 true 时只检查之前已通过的行
+	 */
+	void FilterRows(int32 FirstRow, bool bRefine);
+
+	/** 按排序顺序收集通过过滤的行 */
+	void RebuildVisibleRows();
+
+	TSharedPtr<FObjRefInstanceTable> Table;
+
+	EObjRefInstanceColumn SortColumn;
+	EColumnSortMode::Type SortMode;
+	FString FilterText;
+
+	TArray<int32> SortedRows;
+	TArray<uint8> RowPassesFilter;
+	TArray<int32> VisibleRows;
+
+	/** 名称排序键缓存，行数与结果表不一致时视为失效 */
+	TArray<int64> NameSortKeys;
+
+	/** 对象名称与 Outer 路径的三元组索引，第一次过滤时建立，行号变化后重建 */
+	FObjRefNameIndex NameIndex;
+};
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+
+/**
+ * 作业令牌
+ * 记录作业开始时所属通道的代号，通道开始新作业或被取消后令牌即失效。
+ * 可以按值复制到任意线程，工作线程在循环中协作式地检查 IsCancelled 并尽早退出。
+ * 默认构造的令牌不属于任何通道，永远不会被取消。
+ */
+class FObjRefJobToken
+{
+public:
+	FObjRefJobToken()
+		: Generation(0)
+	{
+	}
+
+	/** 作业是否已被取消或被更新的作业取代 */
+	bool IsCancelled() const
+	{
+		return Counter.IsValid() && Counter->GetValue() != Generation;
+	}
+
+private:
+	friend class FObjRefJobChannel;
+
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> Counter;
+	int32 Generation;
+};
+
+/**
+ * 作业通道
+ * 同一通道上同时只有一个有效作业：开始新作业会让之前发出的所有令牌失效，
+ * 连续的搜索或选择只保留最后一次，过时的工作不会排队执行。只能在游戏线程上开始或取消作业。
+ */
+class FObjRefJobChannel
+{
+public:
+	FObjRefJobChannel()
+		: Counter(MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>())
+	{
+	}
+
+	/** 开始新作业，返回它的令牌 */
+	FObjRefJobToken BeginJob()
+	{
+		FObjRefJobToken Token;
+		Token.Counter = Counter;
+		Token.Generation = Counter->Increment();
+		return Token;
+	}
+
+	/** 取消当前作业 */
+	void Cancel()
+	{
+		Counter->Increment();
+	}
+
+private:
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Counter;
+};
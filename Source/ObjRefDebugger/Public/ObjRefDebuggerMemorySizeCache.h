@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * 对象独占内存统计缓存
+ * 独占内存 = 对象结构体大小 + FArchiveCountMem 统计的容器/堆分配 + GetResourceSizeEx(Exclusive) 报告的资源内存。
+ * 结果按 FObjectKey（索引 + 序列号）缓存，对象槽位被复用后不会误用旧值，重复搜索不再重新统计。
+ */
+class FObjRefMemorySizeCache
+{
+public:
+	FObjRefMemorySizeCache();
+
+	/**
+	 * 获取一批对象的独占内存，未缓存的对象会被批量统计
+	 * 必须在游戏线程调用，统计期间阻止GC；Serialize 与 GetResourceSizeEx 一般只能在游戏线程调用，
+	 * 只有 CanCountInParallel 允许的类分批在工作线程上统计，其余对象都在游戏线程上逐个统计
+	 */
+	void GetExclusiveSizes(const TArray<UObject*>& Objects, TArray<int64>& OutSizes);
+
+	/** 清空缓存 */
+	void Reset();
+
+	/** 当前缓存的对象数 */
+	int32 Num() const { return Sizes.Num(); }
+
+	/** 统计单个对象的独占内存 */
+	static int64 CountExclusiveSize(UObject* Object);
+
+	/** 对象能否在工作线程上统计：最近的原生类在已知安全的白名单中（UObject、UDataAsset、UPrimaryDataAsset） */
+	static bool CanCountInParallel(const UObject* Object);
+
+	/** 并行统计时每个任务处理的对象数 */
+	static constexpr int32 ObjectsPerBatch = 64;
+
+private:
+	/** 移除已销毁对象的缓存项 */
+	void PruneStaleEntries();
+
+	TMap<FObjectKey, int64> Sizes;
+
+	/** 上次清理后的缓存项数，缓存翻倍时再清理一次 */
+	int32 NumEntriesAfterPrune;
+};
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+
+/**
+ * 并行排序
+ * 把数组均分为若干段，在各工作线程上分别排序后逐轮两两归并（每轮内的归并同样并行）。
+ * 归并时相等元素保留左段在前，段内排序不稳定；需要确定的顺序时由谓词自行打破平局。
+ * 元素应当是可以按位复制的小结构（排序键 + 行号）。
+ */
+template<typename ElementType, typename PredicateType>
+void ObjRefParallelSort(TArray<ElementType>& Items, const PredicateType& Predicate)
+{
+	// 每段至少这么多元素，太小的数组直接单线程排序
+	const int32 MinItemsPerChunk = 16 * 1024;
+
+	const int32 NumItems = Items.Num();
+	const int32 NumChunks = FMath::Clamp(NumItems / MinItemsPerChunk, 1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	if (NumChunks == 1)
+	{
+		Algo::Sort(Items, Predicate);
+		return;
+	}
+
+	TArray<int32> ChunkStarts;
+	ChunkStarts.SetNumUninitialized(NumChunks + 1);
+	for (int32 ChunkIndex = 0; ChunkIndex <= NumChunks; ++ChunkIndex)
+	{
+		ChunkStarts[ChunkIndex] = static_cast<int32>(static_cast<int64>(NumItems) * ChunkIndex / NumChunks);
+	}
+
+	ParallelFor(NumChunks, [&Items, &ChunkStarts, &Predicate](int32 ChunkIndex)
+	{
+		Algo::Sort(MakeArrayView(Items.GetData() + ChunkStarts[ChunkIndex], ChunkStarts[ChunkIndex + 1] - ChunkStarts[ChunkIndex]), Predicate);
+	});
+
+	TArray<ElementType> Buffer;
+	Buffer.SetNumUninitialized(NumItems);
+	ElementType* Source = Items.GetData();
+	ElementType* Dest = Buffer.GetData();
+
+	for (int32 Width = 1; Width < NumChunks; Width *= 2)
+	{
+		const int32 NumMerges = (NumChunks + 2 * Width - 1) / (2 * Width);
+		ParallelFor(NumMerges, [Source, Dest, Width, NumChunks, &ChunkStarts, &Predicate](int32 MergeIndex)
+		{
+			const int32 LeftChunk = MergeIndex * 2 * Width;
+			const int32 End = ChunkStarts[FMath::Min(LeftChunk + 2 * Width, NumChunks)];
+			const int32 Middle = ChunkStarts[FMath::Min(LeftChunk + Width, NumChunks)];
+
+			int32 Left = ChunkStarts[LeftChunk];
+			int32 Right = Middle;
+			int32 Out = Left;
+			while (Left < Middle && Right < End)
+			{
+				Dest[Out++] = Predicate(Source[Right], Source[Left]) ? Source[Right++] : Source[Left++];
+			}
+			while (Left < Middle)
+			{
+				Dest[Out++] = Source[Left++];
+			}
+			while (Right < End)
+			{
+				Dest[Out++] = Source[Right++];
+			}
+		});
+		Swap(Source, Dest);
+	}
+
+	if (Source != Items.GetData())
+	{
+		FMemory::Memcpy(Items.GetData(), Source, NumItems * sizeof(ElementType));
+	}
+}
@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Engine/EngineTypes.h"
+#include "ObjRefDebuggerTypes.h"
+#include "ObjRefDebuggerInstanceTable.h"
+
+class FObjRefWorldCache;
+
+/** 查询谓词作用的字段 */
+enum class EObjRefQueryField : uint8
+{
+	Name,        // name:     对象名称
+	Outer,       // outer:    直接 Outer 的路径
+	Within,      // within:   任意一层 Outer 的路径（对象位于该 Outer 树内）
+	Package,     // package:  所在包的名称
+	Flags,       // flags:    对象标志（Standalone / Transient / RootSet / GCRoot）
+	References,  // refs:     引用者数量（结果表列）
+	Size,        // size:     独占内存（结果表列）
+	Retained,    // retained: 保留大小（结果表列）
+};
+
+/** 数值谓词的比较运算 */
+enum class EObjRefQueryCompare : uint8
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual,
+};
+
+/** 候选对象的来源，由查询中选择性最高的谓词决定 */
+enum class EObjRefQuerySource : uint8
+{
+	ClassHash,  // 目标类的类哈希（目标包含 UObject 时扫描整个对象数组）
+	Outer,      // outer: 精确路径，通过 Outer 哈希只枚举该 Outer 的直接子对象
+	OuterTree,  // within: 精确路径，通过 Outer 哈希逐层枚举该 Outer 下的所有嵌套对象
+	Package,    // package: 精确包名，通过包哈希枚举包内的所有对象
+};
+
+/** 一个已编译的谓词 */
+struct FObjRefQueryPredicate
+{
+	EObjRefQueryField Field;
+	EObjRefQueryCompare Compare;
+	bool bNegated;
+
+	/** 字符串谓词的模式，不区分大小写，可包含 * 与 ? 通配符 */
+	FString Pattern;
+
+	/** 模式不含通配符时用于精确比较的名称：name: 为对象名，outer: 与 within: 为路径所指对象的名称（包路径即包名），package: 为包名 */
+	FName ExactName;
+	bool bHasWildcard;
+
+	/** 作为候选来源的精确路径在搜索请求中解析出的对象；绑定后按对象身份比较，不再比较名称与路径 */
+	FWeakObjectPtr ScopeObject;
+	bool bHasScopeObject;
+
+	/** 数值谓词的右值，内存单位已换算为字节 */
+	int64 Number;
+
+	/** flags: 谓词检查的标志 */
+	EObjRefRowFlags Flag;
+
+	FObjRefQueryPredicate()
+		: Field(EObjRefQueryField::Name)
+		, Compare(EObjRefQueryCompare::Equal)
+		, bNegated(false)
+		, bHasWildcard(false)
+		, bHasScopeObject(false)
+		, Number(0)
+		, Flag(EObjRefRowFlags::None)
+	{
+	}
+};
+
+/**
+ * 编译后的实例查询
+ * 查询文本由空格分隔的条件组成，所有条件同时满足才算匹配，例如：
+ *   class:UMaterialInstanceDynamic outer:/Game/UI/* world:PIE refs>3 size>1MB flags:!Standalone
+ * 文本只解析一次，按求值代价把条件排成两条谓词链：
+ * - 对象阶段（name/outer/package/flags/world）在搜索的工作线程上对每个候选对象求值，标志位比较排在字符串匹配之前；
+ * - 结果表阶段（refs/size/retained/flags:GCRoot）依赖引用图和内存统计，在结果表填充后对行求值。
+ * class: 条件不进入谓词链，而是成为搜索的目标类（带 ! 的为排除类），由类哈希枚举候选；
+ * outer:、within: 或 package: 为不含通配符的精确路径时选择性更高，改由 Outer 哈希或包哈希枚举候选，
+ * 搜索代价只与该范围内的对象数有关。
+ * 没有 world: 条件时使用过滤选项中勾选的世界类型；过滤选项中的搜索范围按对应的 outer:/within:/package: 条件加入。
+ * 不带字段名的词按名称子串匹配。
+ */
+class FObjRefQuery
+{
+public:
+	FObjRefQuery();
+
+	/**
+	 * 解析并编译查询文本
+	 * @param Defaults 提供查询中没有 world: 条件时使用的世界类型，以及搜索范围
+	 * @return 语法错误时返回 false，OutError 为错误说明
+	 */
+	static bool Compile(const FString& Text, const FSearchFilterOptions& Defaults, FObjRefQuery& OutQuery, FString& OutError);
+
+	/**
+	 * 对象是否通过默认过滤（排除CDO、待销毁对象、原型）与对象阶段的谓词，可在工作线程调用
+	 * @param WorldCache 按 Outer 缓存的世界解析，世界检查只需一次查表
+	 */
+	bool MatchesObject(UObject* Object, FObjRefWorldCache& WorldCache) const;
+
+	/** 结果行是否通过结果表阶段的谓词 */
+	bool MatchesRow(const FObjRefInstanceTable& Table, int32 Row) const;
+
+	/** 是否接受该世界类型中的对象 */
+	bool AcceptsWorldType(EWorldType::Type WorldType) const;
+
+	/** 查询中是否有作用于该字段的谓词 */
+	bool UsesField(EObjRefQueryField Field) const;
+
+	/** 结果表阶段的谓词是否需要引用图（引用者数量或GC根标志） */
+	bool NeedsReferenceGraph() const;
+
+	bool HasRowPredicates() const { return RowPredicates.Num() > 0; }
+
+	/** class: 条件给出的目标类名与排除类名 */
+	const TArray<FString>& GetClassNames() const { return ClassNames; }
+	const TArray<FString>& GetExcludedClassNames() const { return ExcludedClassNames; }
+
+	/** 候选对象的来源，不是类哈希时 GetSourcePath 为要解析的对象路径 */
+	EObjRefQuerySource GetSource() const { return Source; }
+	const FString& GetSourcePath() const { return SourcePath; }
+
+	/**
+	 * 绑定解析出的候选来源对象，必须在游戏线程调用
+	 * 路径与来源相同的 outer:/within:/package: 条件改为按对象身份比较（Outer 相同、IsIn 或所在包相同），
+	 * 候选本来就由该对象枚举，比较不再受路径写法影响
+	 */
+	void BindSourceObject(UObject* SourceObject);
+
+	const FString& GetText() const { return Text; }
+
+	/** 查询文本中是否没有任何条件 */
+	bool IsEmpty() const { return bIsEmpty; }
+
+	/** 查询语法说明，用作输入框的提示 */
+	static FText GetSyntaxHelp();
+
+private:
+	bool ParseTerm(const FString& Term, FString& OutError);
+	void AddPathPredicate(EObjRefQueryField Field, const FString& Pattern, bool bNegated);
+	void Finalize(const FSearchFilterOptions& Defaults);
+
+	static bool MatchesObjectPredicate(const FObjRefQueryPredicate& Predicate, UObject* Object);
+	static bool MatchesRowPredicate(const FObjRefQueryPredicate& Predicate, const FObjRefInstanceTable& Table, int32 Row);
+
+	FString Text;
+	bool bIsEmpty;
+
+	TArray<FString> ClassNames;
+	TArray<FString> ExcludedClassNames;
+
+	/** 对象阶段的谓词按代价升序排列，前 NumCheapObjectPredicates 个在世界检查之前求值 */
+	TArray<FObjRefQueryPredicate> ObjectPredicates;
+	int32 NumCheapObjectPredicates;
+	TArray<FObjRefQueryPredicate> RowPredicates;
+
+	/** 接受的世界类型，第 0 位表示没有世界的对象，第 1 + EWorldType 位表示对应的世界类型 */
+	uint32 WorldMask;
+
+	/** 解析过程中 world: 条件列出的与排除的世界类型 */
+	uint32 IncludedWorlds;
+	uint32 ExcludedWorlds;
+	bool bHasWorldTerm;
+
+	EObjRefQuerySource Source;
+	FString SourcePath;
+};
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/UObjectArray.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/Atomic.h"
+#include "ObjRefDebuggerJobToken.h"
+
+/** 反向引用边：ReferencerIndex 对应的对象通过 PropertyName 强引用了目标对象 */
+struct FObjRefGraphEdge
+{
+	int32 ReferencerIndex;
+	FName PropertyName;
+
+	FObjRefGraphEdge(int32 InReferencerIndex, FName InPropertyName)
+		: ReferencerIndex(InReferencerIndex)
+		, PropertyName(InPropertyName)
+	{
+	}
+};
+
+/** 最短路径上的一步：ObjectIndex 通过 PropertyId 引用了路径上前一个（更靠近目标的）对象 */
+struct FObjRefPathStep
+{
+	int32 ObjectIndex;
+	int32 PropertyId;
+
+	FObjRefPathStep(int32 InObjectIndex, int32 InPropertyId)
+		: ObjectIndex(InObjectIndex)
+		, PropertyId(InPropertyId)
+	{
+	}
+};
+
+/** GC根的类型 */
+enum class EObjRefRootKind : uint8
+{
+	None,
+	/** 位于根集（AddToRoot） */
+	RootSet,
+	/** 常驻对象，GC永不回收 */
+	DisregardForGC,
+	/** 带有GC保留标记（编辑器中的 RF_Standalone） */
+	KeepFlags
+};
+
+/** 引用图构建模式 */
+enum class EObjRefGraphBuildMode : uint8
+{
+	/** 在调用线程上顺序扫描 */
+	SingleThreaded,
+	/** 按对象索引分块，在所有工作线程上并行收集 */
+	Parallel
+};
+
+/** 增量覆盖层中的一条边：ObjectIndex 为另一端的对象索引 */
+struct FObjRefOverlayEdge
+{
+	int32 ObjectIndex;
+	int32 PropertyId;
+
+	FObjRefOverlayEdge(int32 InObjectIndex, int32 InPropertyId)
+		: ObjectIndex(InObjectIndex)
+		, PropertyId(InPropertyId)
+	{
+	}
+
+	bool operator==(const FObjRefOverlayEdge& Other) const
+	{
+		return ObjectIndex == Other.ObjectIndex && PropertyId == Other.PropertyId;
+	}
+};
+
+/**
+ * 反向引用图
+ * 首次使用时对GUObjectArray做一次完整的强引用收集，之后"谁引用了X"的查询只需 O(入度)。
+ * 通过对象创建/删除监听和GC回调跟踪脏对象，只重新扫描它们的出边并记录在覆盖层中，
+ * 覆盖层过大时再合并为一次完整重建。
+ */
+class FObjRefReferenceGraph : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	FObjRefReferenceGraph();
+	virtual ~FObjRefReferenceGraph();
+
+	/** 没有快照时完整构建，否则只增量处理自上次以来的脏对象 */
+	void EnsureUpToDate();
+
+	/** 完整重建快照，可在任意线程调用，构建期间会阻止GC */
+	void Rebuild(EObjRefGraphBuildMode Mode);
+
+	/** 设置 EnsureUpToDate 使用的构建模式 */
+	void SetBuildMode(EObjRefGraphBuildMode InMode) { BuildMode = InMode; }
+
+	/** 手动作废快照，下次查询时重建 */
+	void Invalidate();
+
+	/** 快照是否存在且没有待处理的脏对象 */
+	bool IsUpToDate() const;
+
+	/** 引用图内容每次变化（完整构建或增量更新）都会递增 */
+	uint32 GetVersion() const { return Version; }
+
+	/** 当前GC周期，每次GC完成后递增 */
+	uint32 GetGCEpoch() const { return GCEpoch; }
+
+	/** 获取直接强引用目标对象的所有边 */
+	void GetReferencers(const UObject* Target, TArray<FObjRefGraphEdge>& OutEdges) const;
+
+	/** 引用图覆盖的对象槽位数 */
+	int32 GetNumObjects() const { return RootKinds.Num(); }
+
+	/** 基础快照中的边总数（不含覆盖层） */
+	int32 GetNumEdges() const { return InSources.Num(); }
+
+	/** 遍历引用 ObjectIndex 的所有对象（反向邻接，已合并覆盖层） */
+	void ForEachReferencer(int32 ObjectIndex, TFunctionRef<void(int32 SourceIndex, int32 PropertyId)> Visitor) const;
+
+	/** 遍历 ObjectIndex 直接引用的所有对象（正向邻接，已合并覆盖层） */
+	void ForEachReference(int32 ObjectIndex, TFunctionRef<void(int32 TargetIndex)> Visitor) const;
+
+	/** 对象是否为GC根 */
+	EObjRefRootKind GetRootKind(int32 ObjectIndex) const { return RootKinds.IsValidIndex(ObjectIndex) ? static_cast<EObjRefRootKind>(RootKinds[ObjectIndex]) : EObjRefRootKind::None; }
+
+	/**
+	 * 在反向图上从目标做广度优先搜索，找出从GC根到目标的最短强引用路径
+	 * 搜索在第一个包含GC根的层次结束，耗时与访问到的子图大小成线性关系
+	 * 可在工作线程调用：期间持有读锁，EnsureUpToDate 会等待搜索结束后再修改引用图
+	 * @param OutPaths 每条路径从目标（含）开始、到GC根（含）结束
+	 * @param CancelToken 令牌失效时搜索提前结束并返回 false
+	 * @return 是否找到至少一条路径
+	 */
+	bool FindShortestPathsToRoot(int32 TargetIndex, int32 MaxPaths, TArray<TArray<FObjRefPathStep>>& OutPaths, const FObjRefJobToken& CancelToken = FObjRefJobToken()) const;
+
+	/** 属性ID对应的属性名 */
+	FName GetPropertyName(int32 PropertyId) const { return PropertyNames.IsValidIndex(PropertyId) ? PropertyNames[PropertyId] : NAME_None; }
+
+	/** 快照占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const;
+
+	/** 按对象索引获取对象，索引无效或对象已不可达时返回nullptr */
+	static UObject* GetObjectByIndex(int32 ObjectIndex);
+
+	/** 并行构建时每个分块包含的对象槽位数 */
+	static constexpr int32 ObjectsPerChunk = 16 * 1024;
+
+	/** 最短路径搜索每扩展这么多个节点检查一次取消令牌 */
+	static constexpr int32 NodesPerCancelCheck = 4096;
+
+	/** 脏对象或覆盖层边数超过基础快照的 1/N 时改为完整重建 */
+	static constexpr int32 MaxDirtyFractionDivisor = 8;
+
+	/** 完整重建阈值的下限，避免小堆上频繁重建 */
+	static constexpr int32 MinFullRebuildThreshold = 4096;
+
+	/** Outer 与 Class 引用使用的伪属性名 */
+	static const FName OuterPropertyName;
+	static const FName ClassPropertyName;
+
+	// === FUObjectCreateListener / FUObjectDeleteListener ===
+
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+	/** GC 完成回调，推进GC周期 */
+	void OnPostGarbageCollect();
+
+	/** 取消所有对象数组监听 */
+	void UnregisterListeners();
+
+	/** 重新扫描脏对象的出边并写入覆盖层 */
+	void ApplyPendingChanges();
+
+	/** 用新的出边替换某个源对象在覆盖层中的出边 */
+	void ReplaceOverlayEdges(int32 SourceIndex, TArray<FObjRefOverlayEdge>&& NewEdges);
+
+	/** 属性名转为属性ID，必要时追加到属性名表 */
+	int32 InternPropertyName(FName PropertyName);
+
+	/** 源对象在基础快照中的出边是否已被覆盖层取代 */
+	bool IsBaseSourceOverridden(int32 SourceIndex) const { return OverriddenSources.IsValidIndex(SourceIndex) && OverriddenSources[SourceIndex]; }
+
+	/** 从 Offsets/Indices 中取出某个对象的邻接区间 */
+	static TArrayView<const int32> GetRange(const TArray<int32>& Offsets, const TArray<int32>& Values, int32 ObjectIndex);
+
+	// === 按 GUObjectArray 索引组织的压缩稀疏行(CSR)基础快照 ===
+
+	/** 反向邻接：对象 i 的引用者位于 InSources[InOffsets[i] .. InOffsets[i+1]) */
+	TArray<int32> InOffsets;
+	TArray<int32> InSources;
+	TArray<int32> InPropertyIds;
+
+	/** 正向邻接：对象 i 引用的对象位于 OutTargets[OutOffsets[i] .. OutOffsets[i+1]) */
+	TArray<int32> OutOffsets;
+	TArray<int32> OutTargets;
+
+	/** 属性名表，边上只保存表中的下标 */
+	TArray<FName> PropertyNames;
+	TMap<FName, int32> PropertyIdsByName;
+
+	/** 每个对象槽位的 EObjRefRootKind */
+	TArray<uint8> RootKinds;
+
+	// === 增量覆盖层 ===
+
+	/** 基础快照中出边已失效的源对象（被重新扫描或已销毁） */
+	TBitArray<> OverriddenSources;
+
+	/** 重新扫描过的源对象的出边 */
+	TMap<int32, TArray<FObjRefOverlayEdge>> OverlayOutEdges;
+
+	/** 覆盖层出边对应的反向边 */
+	TMap<int32, TArray<FObjRefOverlayEdge>> OverlayInEdges;
+
+	int32 NumOverlayEdges;
+
+	/** 等待重新扫描的对象，创建/删除通知可能来自任意线程 */
+	mutable FCriticalSection PendingLock;
+	TSet<int32> PendingDirtyObjects;
+	TSet<int32> PendingDeletedObjects;
+
+	/** 工作线程读取引用图时持有读锁，游戏线程修改引用图时持有写锁 */
+	mutable FRWLock GraphLock;
+
+	/** BFS 访问标记，按搜索序号区分，避免每次搜索都清零整张表；多个搜索之间由 SearchLock 串行化 */
+	mutable FCriticalSection SearchLock;
+	mutable TArray<uint32> VisitStamps;
+	mutable uint32 CurrentVisitStamp;
+
+	uint32 GCEpoch;
+	uint32 Version;
+
+	/** 是否已有完整快照；创建/删除通知在任意线程读取 */
+	TAtomic<bool> bHasSnapshot;
+	bool bListenersRegistered;
+
+	EObjRefGraphBuildMode BuildMode;
+
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+class FObjRefReferenceGraph;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * 堆快照文件格式（.objrefsnap）
+ * 文件按下面的顺序排列，各段起始偏移按 8 字节对齐，所有整数为小端序：
+ *   文件头      FObjRefSnapshotHeader
+ *   字符串偏移  uint32[NumStrings + 1]，字符串数据中的字节偏移，最后一项为数据总长
+ *   字符串数据  UTF-8，每个字符串以 0 结尾（对象名与类路径，各自去重）
+ *   对象记录    FObjRefSnapshotRecord[NumRecords]，按对象索引升序排列
+ *   边偏移      uint64[NumRecords + 1]，记录 i 的出边位于边目标的 [EdgeOffsets[i], EdgeOffsets[i+1])
+ *   边目标      int32[NumEdges]，被强引用对象的记录下标
+ * 所有段都是定长数组，读取端映射文件后直接把各段偏移解释为数组，打开时不做任何解析或拷贝。
+ */
+struct FObjRefSnapshotHeader
+{
+	uint32 Magic;
+	uint32 Version;
+
+	/** 文件头与对象记录的字节数，读取端据此拒绝不兼容的布局 */
+	uint32 HeaderSize;
+	uint32 RecordSize;
+
+	/** 捕获时间（FDateTime UTC ticks） */
+	int64 CaptureTime;
+
+	uint32 NumRecords;
+	uint32 NumStrings;
+	uint64 NumEdges;
+
+	// 各段在文件中的字节偏移
+	uint64 StringOffsetsOffset;
+	uint64 StringDataOffset;
+	uint64 StringDataSize;
+	uint64 RecordsOffset;
+	uint64 EdgeOffsetsOffset;
+	uint64 EdgeTargetsOffset;
+	uint64 FileSize;
+
+	static constexpr uint32 ExpectedMagic = 0x4E53524F; // "ORSN"
+	static constexpr uint32 CurrentVersion = 1;
+};
+static_assert(sizeof(FObjRefSnapshotHeader) == 96, "快照文件头布局已改变，需要递增 CurrentVersion");
+
+/** 快照中的一个对象，定长 32 字节 */
+struct FObjRefSnapshotRecord
+{
+	/** 捕获时在 GUObjectArray 中的索引 */
+	int32 ObjectIndex;
+
+	/** 对象名与类路径在字符串表中的下标 */
+	int32 NameId;
+	int32 ClassId;
+
+	/** Outer 的记录下标，没有 Outer 时为 -1 */
+	int32 OuterRecord;
+
+	/** EObjectFlags */
+	uint32 ObjectFlags;
+
+	/** EObjRefRootKind */
+	uint8 RootKind;
+	uint8 Reserved[3];
+
+	/** 类的结构体大小（字节） */
+	int64 Size;
+};
+static_assert(sizeof(FObjRefSnapshotRecord) == 32, "快照记录布局已改变，需要递增 CurrentVersion");
+
+/**
+ * 堆快照写入
+ * 从引用图读取每个可达对象的出边，连同对象索引、名称、类、Outer、标志和大小写成一个快照文件，
+ * 之后可以脱离编辑器会话离线分析（例如构建机上夜间运行后取回文件）。
+ * 也可以通过控制台命令 ObjRefDebugger.CaptureSnapshot [路径] 在没有打开窗口时捕获。
+ */
+class FObjRefSnapshotWriter
+{
+public:
+	/**
+	 * 捕获当前堆并写入文件，必须在游戏线程调用；期间阻止GC
+	 * 先写入同目录的临时文件，完成后再改名，中途失败不会留下不完整的快照
+	 * @param OutHeader 写入的文件头
+	 * @return 失败时返回 false，OutError 为原因
+	 */
+	static bool Capture(FObjRefReferenceGraph& Graph, const FString& Path, FObjRefSnapshotHeader& OutHeader, FString& OutError);
+
+	/** 快照文件的扩展名 */
+	static const TCHAR* GetFileExtension() { return TEXT("objrefsnap"); }
+
+	/** 控制台命令没有给出路径时使用的默认路径（Saved/ObjRefSnapshots 下按时间命名） */
+	static FString MakeDefaultPath();
+};
+
+/**
+ * 只读的快照视图
+ * 通过内存映射打开快照文件，各段直接作为数组访问，不做解析或拷贝；打开时校验文件头与各段边界，
+ * 再线性检查一遍偏移表、记录中的下标和边目标，损坏的文件在打开时被拒绝，之后的读取不会越界。
+ * 平台不支持内存映射时退回为整体读入内存。
+ */
+class FObjRefSnapshotView
+{
+public:
+	FObjRefSnapshotView();
+	~FObjRefSnapshotView();
+
+	bool Open(const FString& Path, FString& OutError);
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+
+	const FObjRefSnapshotHeader& GetHeader() const { return *reinterpret_cast<const FObjRefSnapshotHeader*>(Data); }
+
+	int32 Num() const { return IsOpen() ? static_cast<int32>(GetHeader().NumRecords) : 0; }
+
+	const FObjRefSnapshotRecord& GetRecord(int32 RecordIndex) const { return Records[RecordIndex]; }
+
+	/** 字符串表中的字符串（UTF-8） */
+	const ANSICHAR* GetString(int32 StringId) const { return StringData + StringOffsets[StringId]; }
+
+	/** 记录直接强引用的对象（记录下标） */
+	TArrayView<const int32> GetReferences(int32 RecordIndex) const;
+
+	/** 按捕获时的对象索引查找记录，二分查找，找不到时返回 INDEX_NONE */
+	int32 FindRecord(int32 ObjectIndex) const;
+
+private:
+	/** 校验文件头、各段边界与各段内容，通过后设置各段指针 */
+	bool Bind(const uint8* InData, int64 InSize, FString& OutError);
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FallbackBuffer;
+
+	const uint8* Data;
+	const uint32* StringOffsets;
+	const ANSICHAR* StringData;
+	const FObjRefSnapshotRecord* Records;
+	const uint64* EdgeOffsets;
+	const int32* EdgeTargets;
+};
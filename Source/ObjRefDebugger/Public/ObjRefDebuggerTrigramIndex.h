@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FObjRefInstanceTable;
+
+/**
+ * 三元组倒排索引
+ * 一组字符串（文档）按小写存放在一个连续的字符串池中，每个文档的所有三元组（连续三个字符）
+ * 以CSR结构记录：只为实际出现的三元组建表，TrigramKeys 按升序存放三元组编码，
+ * 第 k 个三元组出现过的文档位于 Postings[TrigramOffsets[k] .. TrigramOffsets[k+1])，按文档ID升序。
+ * 子串查询对查询串的三元组求交集得到候选文档，再在字符串池中逐个验证；短于三个字符的查询直接扫描字符串池。
+ * 三元组按字符低7位编码，非ASCII字符可能冲突，验证保证结果正确。
+ */
+class FObjRefTrigramIndex
+{
+public:
+	FObjRefTrigramIndex();
+
+	/** 用一组字符串重建索引，字符串的下标即文档ID */
+	void Build(const TArray<FString>& Documents);
+
+	/**
+	 * 查找包含查询串的文档，按文档ID升序输出
+	 * @param LowerQuery 已转为小写的查询串
+	 * @param bPrefix 为 true 时只匹配以查询串开头的文档
+	 */
+	void FindDocuments(const FString& LowerQuery, bool bPrefix, TArray<int32>& OutDocuments) const;
+
+	int32 NumDocuments() const { return FMath::Max(DocumentOffsets.Num() - 1, 0); }
+
+	/** 索引占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** 文档在字符串池中的起始位置（以 '\0' 结尾） */
+	const TCHAR* GetDocument(int32 DocumentId) const { return Pool.GetData() + DocumentOffsets[DocumentId]; }
+
+	/** 文档是否匹配查询串 */
+	bool MatchDocument(int32 DocumentId, const FString& LowerQuery, bool bPrefix) const;
+
+	TArray<TCHAR> Pool;
+	TArray<int32> DocumentOffsets;
+	TArray<uint32> TrigramKeys;
+	TArray<int32> TrigramOffsets;
+	TArray<int32> Postings;
+};
+
+/**
+ * 结果表的名称与路径索引
+ * 对象名称以行号为文档ID建立三元组索引；对象的 Outer 路径先驻留（同一 Outer 下的对象共用一条路径），
+ * 再对驻留后的路径建立索引。查询时分别匹配名称与 Outer 路径，任意一个命中即视为该行匹配。
+ * 查询以 "^" 开头时为前缀匹配，例如 "^/Game/Maps/Arena" 匹配该关卡包下的所有对象。
+ * 名称和 Outer 路径分别匹配，跨越两者之间分隔符的子串不会命中。
+ * 在游戏线程上构建，查询不访问任何 UObject。
+ */
+class FObjRefNameIndex
+{
+public:
+	FObjRefNameIndex();
+
+	/** 为结果表的所有行重建索引 */
+	void Build(const FObjRefInstanceTable& Table);
+
+	/** 把索引标记为过期，下一次查询前需要重建 */
+	void Invalidate() { bIsValid = false; }
+
+	/** 索引是否对应行数为 NumRows 的结果表 */
+	bool IsUpToDate(int32 NumRows) const { return bIsValid && NumRows == OuterIdOfRow.Num(); }
+
+	/** 把名称或 Outer 路径匹配查询的行置为 1，OutRowMatches 的长度与行数一致 */
+	void MatchRows(const FString& Query, TArray<uint8>& OutRowMatches) const;
+
+	/** 解析查询：去掉前缀标记并转为小写 */
+	static void ParseQuery(const FString& Query, FString& OutLowerText, bool& bOutPrefix);
+
+	/** 不经过索引直接判断对象是否匹配已解析的查询，用于尚未建立索引的新行 */
+	static bool MatchObject(const UObject* Object, const FString& LowerText, bool bPrefix);
+
+	/** 索引占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FObjRefTrigramIndex NameIndex;
+	FObjRefTrigramIndex OuterPathIndex;
+
+	/** 每行对象的 Outer 路径ID，没有 Outer 时为 INDEX_NONE */
+	TArray<int32> OuterIdOfRow;
+
+	bool bIsValid;
+};
@@ -5,45 +5,6 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 
-/** 对象列表项数据结构 */
-struct FObjectListItem
-{
-	UObject* Object;
-	FString ObjectName;
-	FString ClassName;
-	FString WorldName;
-	int32 MemorySize;
-	int32 ReferenceCount;  // 引用者数量
-	bool bIsGCRoot;        // 是否为GC根
-	
-	FObjectListItem(UObject* InObject)
-		: Object(InObject)
-		, MemorySize(0)
-		, ReferenceCount(0)
-		, bIsGCRoot(false)
-	{
-		if (IsValid(InObject))
-		{
-			ObjectName = InObject->GetName();
-			ClassName = InObject->GetClass()->GetName();
-			UWorld* ObjectWorld = InObject->GetWorld();
-			WorldName = ObjectWorld ? ObjectWorld->GetName() : TEXT("无世界");
-			
-			// 计算内存大小
-			if (InObject->GetClass())
-			{
-				MemorySize = InObject->GetClass()->GetStructureSize();
-			}
-		}
-		else
-		{
-			ObjectName = TEXT("Invalid Object");
-			ClassName = TEXT("Unknown");
-			WorldName = TEXT("Unknown");
-		}
-	}
-};
-
 /** 引用者信息数据结构 */
 struct FReferencerInfo
 {
@@ -76,6 +37,9 @@ struct FReferenceChainNode
 	FString PropertyName;  // 引用此对象的属性名
 	int32 Depth;
 	bool bIsGCRoot;
+	int32 ComponentId;     // 所在强连通分量，INDEX_NONE 表示未知
+	int32 ClusterSize;     // 大于1时表示该节点代表一个循环引用簇
+	bool bChildrenPending; // 子节点尚未生成，展开时再构建（此时 Children 中只有占位节点）
 	TArray<TSharedPtr<FReferenceChainNode>> Children;
 	TWeakPtr<FReferenceChainNode> Parent;
 	
@@ -83,6 +47,9 @@ struct FReferenceChainNode
 		: Object(InObject)
 		, Depth(InDepth)
 		, bIsGCRoot(false)
+		, ComponentId(INDEX_NONE)
+		, ClusterSize(1)
+		, bChildrenPending(false)
 	{
 		if (IsValid(InObject))
 		{
@@ -98,6 +65,22 @@ struct FReferenceChainNode
 	}
 };
 
+/** 引用链构建模式 */
+enum class EReferenceChainMode : uint8
+{
+	ShortestPath,  // 反向图上的广度优先搜索，只显示从GC根到目标的最短路径
+	AllPaths       // 深度优先穷举所有引用路径，受最大深度限制
+};
+
+/** 搜索范围 */
+enum class EObjRefScopeMode : uint8
+{
+	Global,     // 整个堆
+	Outer,      // 指定对象的直接子对象
+	OuterTree,  // 指定对象下任意层级的嵌套对象
+	Package     // 指定包内的所有对象
+};
+
 /** 搜索过滤选项 */
 struct FSearchFilterOptions
 {
@@ -108,7 +91,17 @@ struct FSearchFilterOptions
 	bool bShowReferenceChain = true;
 	bool bShowStatistics = true;
 	bool bAutoRefresh = false;
-	int32 MaxReferenceDepth = 5;
+	bool bParallelGraphBuild = true;  // 在所有工作线程上并行构建引用图
+	bool bComputeRetainedSize = false; // 搜索完成后通过支配树计算保留大小（全堆计算，默认关闭）
+	bool bComputeResourceSize = false; // 搜索完成后统计独占内存（FArchiveCountMem + GetResourceSizeEx）
+	bool bTimeSlicedSearch = false; // 在游戏线程上分帧扫描对象数组，结果逐帧显示
+	float TimeSliceBudgetMs = 4.0f; // 分帧搜索每帧的时间预算（毫秒）
+	int32 MaxReferenceDepth = 5;   // 最短路径模式下超出部分折叠显示；穷举模式按需展开，不受限制
+	int32 MaxShortestPaths = 8;    // 最短路径模式下最多显示的路径数
+	int32 AnalysisCacheBudgetMB = 64; // 引用者与引用链缓存的内存预算（MB），超出时淘汰最久未选择的对象
+	EReferenceChainMode ReferenceChainMode = EReferenceChainMode::ShortestPath;
+	EObjRefScopeMode ScopeMode = EObjRefScopeMode::Global;
+	FString ScopePath;             // 搜索范围的对象路径或包名，整个堆时忽略
 	
 	FSearchFilterOptions() {}
 };
@@ -163,6 +156,24 @@ struct FSearchHistoryItem
 	{}
 };
 
+/** 刷新后从结果中移除的实例，对象多半已被回收，显示内容在比较时从旧结果表中取出 */
+struct FRemovedInstanceInfo
+{
+	FString ObjectName;
+	FString ClassName;
+	FString WorldName;
+	int64 MemorySize;
+	bool bCollected; // 对象已被回收；否则对象仍然存在，只是不再满足搜索条件
+	
+	FRemovedInstanceInfo(const FString& InObjectName, const FString& InClassName, const FString& InWorldName, int64 InMemorySize, bool bInCollected)
+		: ObjectName(InObjectName)
+		, ClassName(InClassName)
+		, WorldName(InWorldName)
+		, MemorySize(InMemorySize)
+		, bCollected(bInCollected)
+	{}
+};
+
 /** UI主题颜色 */
 struct FDebuggerTheme
 {
@@ -171,6 +182,9 @@ struct FDebuggerTheme
 	FLinearColor IndirectReferenceColor = FLinearColor::Gray;
 	FLinearColor StrongReferenceColor = FLinearColor::Red;
 	FLinearColor WeakReferenceColor = FLinearColor::Blue;
+	FLinearColor ClusterColor = FLinearColor(1.0f, 0.5f, 0.0f, 1.0f);
+	FLinearColor AddedRowColor = FLinearColor(0.35f, 0.9f, 0.35f, 1.0f);
+	FLinearColor RemovedRowColor = FLinearColor(0.9f, 0.35f, 0.35f, 1.0f);
 	FLinearColor PrimaryTextColor = FLinearColor::White;
 	FLinearColor SecondaryTextColor = FLinearColor(0.7f, 0.7f, 0.7f, 1.0f);
 	FLinearColor BackgroundColor = FLinearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+class UWorld;
+
+/**
+ * 按 Outer 缓存的世界解析
+ * 普通 UObject 的 GetWorld 沿 Outer 链逐层递归，同一 Outer 下的兄弟对象会重复走完整条链。
+ * 这里按 Outer 的对象索引记录 Outer->GetWorld() 的结果，每个 Outer 只解析一次，同一 Outer 下的其他对象只需一次查表。
+ * 表在搜索开始时按对象数组大小分配，多个工作线程并发读写同一张表：同一项只会被写入相同的值，原子读写即可，无需加锁。
+ * 对象的世界按其 Outer 的世界计算（与 UObject::GetWorld 的默认实现一致，Actor、组件、关卡也都由 Outer 得到世界）；
+ * UWorld 自身直接返回自己。少数不经 Outer 取得世界的类型（如 UGameInstance）按 Outer 链归类。
+ * 表中的对象索引只在一个GC周期内有效，发生GC后必须 Reset。
+ */
+class FObjRefWorldCache
+{
+public:
+	FObjRefWorldCache();
+
+	/** 按当前对象数组大小清空缓存，需要在没有其他线程使用缓存时调用 */
+	void Reset();
+
+	/** 对象所在世界的对象索引，没有世界时返回 INDEX_NONE，可在多个工作线程上并发调用 */
+	int32 GetWorldIndex(const UObject* Object);
+
+	/** 对象所在的世界，可在多个工作线程上并发调用 */
+	UWorld* GetWorld(const UObject* Object);
+
+	/** 缓存占用的内存字节数 */
+	SIZE_T GetAllocatedSize() const { return WorldByOuter.GetAllocatedSize(); }
+
+private:
+	/** Outer 对象索引 -> 编码后的世界：0 表示尚未解析，1 表示没有世界，其余为世界的对象索引 + 2 */
+	TArray<int32> WorldByOuter;
+};
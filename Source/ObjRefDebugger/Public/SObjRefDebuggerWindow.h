@@ -6,8 +6,13 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Views/STreeView.h"
+#include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Async/Future.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "UObject/ObjectKey.h"
 #include "ObjRefDebuggerTypes.h"
+#include "ObjRefDebuggerJobToken.h"
 #include "SObjRefDebuggerClassPicker.h"
 
 class SEditableTextBox;
@@ -16,6 +21,20 @@ class SSplitter;
 class SCheckBox;
 class SProgressBar;
 class STextBlock;
+class FObjRefReferenceGraph;
+class FObjRefDominatorTree;
+class FObjRefMemorySizeCache;
+class FObjRefCondensedGraph;
+class FObjRefClassIndex;
+class FObjRefAnalysisCache;
+struct FObjRefAnalysisStamp;
+struct FObjRefSearchRequest;
+class FObjRefTimeSlicedSearch;
+class FObjRefInstanceTable;
+class FObjRefRowTextCache;
+class FObjRefInstanceView;
+class FObjRefQuery;
+struct FObjRefPathStep;
 
 /** 主调试器窗口类 */
 class SObjRefDebuggerWindow : public SCompoundWidget
@@ -25,6 +44,8 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	
+	virtual ~SObjRefDebuggerWindow();
 
 private:
 	// === UI 事件处理 ===
@@ -32,6 +53,9 @@ private:
 	/** 搜索按钮点击事件 */
 	FReply OnSearchClicked();
 	
+	/** 取消搜索按钮点击事件 */
+	FReply OnCancelSearchClicked();
+	
 	/** 清除结果按钮点击事件 */
 	FReply OnClearResultsClicked();
 	
@@ -44,6 +68,18 @@ private:
 	/** 强制GC按钮点击事件 */
 	FReply OnForceGCClicked();
 	
+	/** 捕获快照按钮点击事件：把整个堆的对象与强引用边写入快照文件 */
+	FReply OnCaptureSnapshotClicked();
+	
+	/** 实例列表表头排序事件 */
+	void OnInstanceColumnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type SortMode);
+	
+	/** 实例列表表头的排序状态 */
+	EColumnSortMode::Type GetInstanceColumnSortMode(FName ColumnId) const;
+	
+	/** 实例过滤文本改变事件 */
+	void OnInstanceFilterTextChanged(const FText& FilterText);
+	
 	/** 类选择改变事件 */
 	void OnClassSelected(UClass* SelectedClass);
 	
@@ -51,7 +87,10 @@ private:
 	void RemoveSelectedClass(const FString& ClassName);
 	
 	/** 对象实例列表选择改变事件 */
-	void OnObjectSelectionChanged(TSharedPtr<FObjectListItem> SelectedItem, ESelectInfo::Type SelectInfo);
+	void OnObjectSelectionChanged(TWeakObjectPtr<UObject> SelectedItem, ESelectInfo::Type SelectInfo);
+	
+	/** 引用链树节点展开事件，按需生成子节点 */
+	void OnReferenceChainExpansionChanged(TSharedPtr<FReferenceChainNode> Item, bool bExpanded);
 	
 	/** 引用链树节点选择改变事件 */
 	void OnReferenceChainSelectionChanged(TSharedPtr<FReferenceChainNode> SelectedItem, ESelectInfo::Type SelectInfo);
@@ -70,11 +109,20 @@ private:
 	
 	/** 获取当前视图模式文本 */
 	FText GetCurrentViewModeText() const;
+	
+	/** 搜索范围选择变化事件 */
+	void OnScopeModeSelectionChanged(TSharedPtr<FText> SelectedItem, ESelectInfo::Type SelectInfo);
+	
+	/** 获取当前搜索范围文本 */
+	FText GetCurrentScopeModeText() const;
 
 	// === UI 生成器 ===
 	
 	/** 生成对象列表行 */
-	TSharedRef<ITableRow> OnGenerateObjectRow(TSharedPtr<FObjectListItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateObjectRow(TWeakObjectPtr<UObject> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	
+	/** 生成对象列表行中一列的内容 */
+	TSharedRef<SWidget> GenerateObjectCell(const FName& ColumnId, TWeakObjectPtr<UObject> Item);
 	
 	/** 生成引用者列表行 */
 	TSharedRef<ITableRow> OnGenerateReferencerRow(TSharedPtr<FReferencerInfo> Item, const TSharedRef<STableViewBase>& OwnerTable);
@@ -85,6 +133,9 @@ private:
 	/** 生成搜索历史行 */
 	TSharedRef<ITableRow> OnGenerateSearchHistoryRow(TSharedPtr<FSearchHistoryItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
 	
+	/** 生成刷新后被移除的实例行 */
+	TSharedRef<ITableRow> OnGenerateRemovedInstanceRow(TSharedPtr<FRemovedInstanceInfo> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	
 	/** 生成已选择类行 */
 	TSharedRef<ITableRow> OnGenerateSelectedClassRow(TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& OwnerTable);
 	
@@ -114,7 +165,7 @@ private:
 	// === 核心功能 ===
 	
 	/** 查找指定类的所有实例 */
-	void FindInstancesOfClass(const FString& ClassName, TArray<TSharedPtr<FObjectListItem>>& OutInstances);
+	void FindInstancesOfClass(const FString& ClassName, TArray<TWeakObjectPtr<UObject>>& OutInstances);
 	
 	/** 查找对象的引用者 */
 	void FindObjectReferencers(UObject* TargetObject, TArray<TSharedPtr<FReferencerInfo>>& OutReferencers);
@@ -122,11 +173,35 @@ private:
 	/** 构建引用链到GC根 */
 	void BuildReferenceChainToRoot(UObject* TargetObject, TArray<TSharedPtr<FReferenceChainNode>>& OutRootNodes);
 	
-	/** 递归构建引用链 */
-	void BuildReferenceChainRecursive(TSharedPtr<FReferenceChainNode> CurrentNode, TSet<UObject*>& VisitedObjects, int32 MaxDepth);
+	/** 通过反向图广度优先搜索构建从GC根到目标的最短引用链 */
+	void BuildShortestReferenceChains(UObject* TargetObject, TArray<TSharedPtr<FReferenceChainNode>>& OutRootNodes);
+	
+	/** 把最短路径合并为以目标为根的引用链树 */
+	void BuildShortestReferenceChainNodes(UObject* TargetObject, const TArray<TArray<FObjRefPathStep>>& Paths, TArray<TSharedPtr<FReferenceChainNode>>& OutRootNodes);
 	
-	/** 过滤对象（排除CDO、待销毁对象等） */
-	bool ShouldIncludeObject(UObject* Object, const FSearchFilterOptions& FilterOptions) const;
+	/** 在工作线程上查找最短引用链，令牌失效时结果直接丢弃 */
+	void StartShortestChainAnalysis(UObject* TargetObject, const FObjRefJobToken& Token);
+	
+	/** 最短引用链查找完成，在游戏线程上生成引用链树 */
+	void OnShortestChainAnalysisComplete(UObject* TargetObject, const TArray<TArray<FObjRefPathStep>>& Paths, const FObjRefAnalysisStamp& Stamp);
+	
+	/** 为搜索结果填充独占内存 */
+	void UpdateExclusiveSizes(FObjRefInstanceTable& Table);
+	
+	/** 通过支配树为搜索结果填充保留大小 */
+	void UpdateRetainedSizes(FObjRefInstanceTable& Table);
+	
+	/** 从引用图快照为搜索结果填充引用者数量与GC根标志 */
+	void UpdateReferenceCounts(FObjRefInstanceTable& Table);
+	
+	/** 搜索完成后填充内存与引用列，并按查询中结果表阶段的条件移除不匹配的行 */
+	void FinalizeSearchResults(FObjRefInstanceTable& Table, const FObjRefQuery& Query);
+	
+	/** 在强连通分量缩合图上为节点生成一层子节点，更深的引用者在展开时再生成 */
+	void ExpandReferenceChainNode(TSharedPtr<FReferenceChainNode> CurrentNode);
+	
+	/** 为循环引用簇节点添加成员列表 */
+	void AddClusterMemberNodes(TSharedPtr<FReferenceChainNode> ClusterNode);
 	
 	/** 获取指定世界类型的世界对象 */
 	UWorld* GetWorldByType(EWorldType::Type WorldType) const;
@@ -142,11 +217,50 @@ private:
 	/** 异步搜索任务 */
 	void StartAsyncSearch(const FString& ClassName);
 	
-	/** 异步多类搜索任务 */
+	/** 异步多类搜索任务，取代正在进行的搜索 */
 	void StartAsyncMultiClassSearch(const TArray<FString>& ClassNames);
 	
-	/** 异步搜索完成回调 */
-	void OnAsyncSearchComplete(TArray<TSharedPtr<FObjectListItem>> Results);
+	/** 取消正在进行的搜索 */
+	void CancelSearch();
+	
+	/** 在游戏线程上编译查询、解析目标类和所选世界，生成可交给后台线程的搜索请求 */
+	bool BuildSearchRequest(const TArray<FString>& ClassNames, FObjRefSearchRequest& OutRequest);
+	
+	/** 是否选择了类、输入了查询条件或指定了搜索范围 */
+	bool HasSearchCriteria() const;
+	
+	/** 搜索结果缓存键：已选择的类加上查询文本与搜索范围 */
+	FString MakeSearchCacheKey(const TArray<FString>& ClassNames) const;
+	
+	/** 启动分帧搜索，由编辑器 Ticker 每帧推进 */
+	void StartTimeSlicedSearch(const FObjRefSearchRequest& Request, const FString& CacheKey);
+	
+	/** 在时间预算内推进分帧搜索，并把新结果追加到列表 */
+	bool TickTimeSlicedSearch(float DeltaTime);
+	
+	/** 分帧搜索期间发生GC，从弱引用结果重建列表，去掉已被回收的对象 */
+	void OnTimeSlicedSearchGarbageCollected();
+	
+	/** 分帧搜索完成：统计内存、更新统计信息与缓存 */
+	void FinishTimeSlicedSearch();
+	
+	/** 停止分帧搜索并注销 Ticker 与GC回调 */
+	void StopTimeSlicedSearch();
+	
+	/** 搜索进度，分帧搜索返回扫描比例，并行搜索返回空（不确定进度） */
+	TOptional<float> GetSearchProgress() const;
+	
+	/** 异步搜索完成回调，CacheKey 与当前显示的结果相同时按差异增量刷新 */
+	void OnAsyncSearchComplete(TSharedPtr<FObjRefInstanceTable> Results, const FObjRefQuery& Query, const FString& CacheKey);
+	
+	/** 把当前结果表与同一搜索条件下的上一次结果比较，记录新增与移除的实例；PreviousTable 为空时清除差异 */
+	void UpdateResultDiff(const FObjRefInstanceTable* PreviousTable);
+	
+	/** 对象是否为上次刷新新增的实例 */
+	bool IsAddedInstance(const TWeakObjectPtr<UObject>& Item) const;
+	
+	/** 按实例视图当前的排序与过滤结果重建列表数据源 */
+	void RefreshInstanceList();
 	
 	/** 添加到搜索历史 */
 	void AddToSearchHistory(const FString& ClassName, int32 ResultCount, float SearchDuration);
@@ -171,12 +285,13 @@ private:
 	// === UI 控件 ===
 	
 	TSharedPtr<SObjRefDebuggerClassPicker> ClassPicker;
-	TSharedPtr<SListView<TSharedPtr<FObjectListItem>>> ObjectListView;
+	TSharedPtr<SListView<TWeakObjectPtr<UObject>>> ObjectListView;
 	TSharedPtr<SListView<TSharedPtr<FReferencerInfo>>> ReferencerListView;
 	TSharedPtr<STreeView<TSharedPtr<FReferenceChainNode>>> ReferenceChainTreeView;
 	TSharedPtr<SListView<TSharedPtr<FSearchHistoryItem>>> SearchHistoryListView;
 	TSharedPtr<SProgressBar> SearchProgressBar;
 	TSharedPtr<SListView<TSharedPtr<FString>>> SelectedClassListView;
+	TSharedPtr<SListView<TSharedPtr<FRemovedInstanceInfo>>> RemovedInstanceListView;
 	
 	// 过滤选项控件
 	TSharedPtr<SCheckBox> IncludeEditorWorldCheckBox;
@@ -197,26 +312,75 @@ private:
 	// 视图模式相关
 	TArray<TSharedPtr<FText>> ViewModeOptions;
 	
+	// 搜索范围选项，顺序与 EObjRefScopeMode 一致
+	TArray<TSharedPtr<FText>> ScopeModeOptions;
+	
 	// === 数据源 ===
 	
-	TArray<TSharedPtr<FObjectListItem>> ObjectInstances;
+	/** 实例列表的数据源，只保存弱引用，行数据位于 InstanceTable */
+	TArray<TWeakObjectPtr<UObject>> ObjectInstances;
+	TSharedPtr<FObjRefInstanceTable> InstanceTable;
+	TSharedPtr<FObjRefRowTextCache> RowTextCache;
+	TSharedPtr<FObjRefInstanceView> InstanceView;
 	TArray<TSharedPtr<FReferencerInfo>> ReferencerInfos;
 	TArray<TSharedPtr<FReferenceChainNode>> ReferenceChainRoots;
 	TArray<TSharedPtr<FSearchHistoryItem>> SearchHistory;
 	
+	/** 上次刷新相对于之前结果的差异：新增的实例按对象键高亮，移除的实例单独列出 */
+	TSet<FObjectKey> AddedInstances;
+	TArray<TSharedPtr<FRemovedInstanceInfo>> RemovedInstances;
+	int32 NumUnchangedInstances;
+	bool bHasResultDiff;
+	
+	/** 列表当前显示的完整结果对应的缓存键，同一键的新结果按差异刷新 */
+	FString DisplayedResultsKey;
+	
 	// === 状态管理 ===
 	
 	TArray<TSharedPtr<FString>> CurrentClassNames;
+	FString CurrentQueryText;
 	FSearchFilterOptions CurrentFilterOptions;
 	FSearchStatistics CurrentStatistics;
-	TSharedPtr<FObjectListItem> CurrentSelectedObject;
+	TWeakObjectPtr<UObject> CurrentSelectedObject;
 	
 	// === 性能优化 ===
 	
 	bool bIsSearching;
-	TMap<FString, TArray<TSharedPtr<FObjectListItem>>> CachedSearchResults;
-	TMap<UObject*, TArray<TSharedPtr<FReferencerInfo>>> CachedReferencers;
-	TMap<UObject*, TArray<TSharedPtr<FReferenceChainNode>>> CachedReferenceChains;
+	TMap<FString, TSharedPtr<FObjRefInstanceTable>> CachedSearchResults;
+	
+	/** 反向引用图快照，每个GC周期构建一次 */
+	TSharedPtr<FObjRefReferenceGraph> ReferenceGraph;
+	
+	/** 引用图上的支配树，引用图版本变化后重新计算 */
+	TSharedPtr<FObjRefDominatorTree> DominatorTree;
+	
+	/** 按对象键缓存的独占内存，重复搜索不再重新统计 */
+	TSharedPtr<FObjRefMemorySizeCache> MemorySizeCache;
+	
+	/** 引用图的强连通分量缩合，穷举引用链时使用 */
+	TSharedPtr<FObjRefCondensedGraph> CondensedGraph;
+	
+	/** 类名到 UClass 的索引，替代逐个遍历 UClass 比较类名 */
+	TSharedPtr<FObjRefClassIndex> ClassIndex;
+	
+	/** 按对象键缓存的引用者列表与引用链，GC后失效，超出内存预算时按LRU淘汰 */
+	TSharedPtr<FObjRefAnalysisCache> AnalysisCache;
+	
+	/** 搜索作业与选择对象后的引用分析作业，新作业开始时旧作业的令牌失效 */
+	FObjRefJobChannel SearchJobs;
+	FObjRefJobChannel AnalysisJobs;
+	
+	/** 仍可能在工作线程上读取引用图的分析任务，窗口销毁前等待它们结束 */
+	TArray<TFuture<void>> AnalysisTasks;
+	
+	/** 正在进行的分帧搜索 */
+	TSharedPtr<FObjRefTimeSlicedSearch> TimeSlicedSearch;
+	FString TimeSlicedSearchCacheKey;
+	
+	/** 分帧搜索开始前显示的同一条件的结果，搜索完成后与新结果比较 */
+	TSharedPtr<FObjRefInstanceTable> TimeSlicedPreviousTable;
+	FDelegateHandle TimeSlicedSearchTickerHandle;
+	FDelegateHandle TimeSlicedSearchGCHandle;
 	float LastSearchTime;
 	FDateTime LastRefreshTime;
 	